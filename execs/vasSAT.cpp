@@ -1,12 +1,14 @@
 #include <exception>
 #include <fstream>
+#include <sstream>
 
 #include "cxxopts/cxxopts.hpp"
 #include "vasSAT/CNFFormula.hpp"
 #include "vasSAT/FileUtils.hpp"
 #include "vasSAT/Solver.hpp"
+#include "vasSAT/ipasir.h"
 
-static cxxopts::Options options("vasSAT", "A classical DPLL Sat Solver");
+static cxxopts::Options options("vasSAT", "A CDCL and classical DPLL Sat Solver");
 
 int main(int argc, char *argv[]) {
   using namespace std;
@@ -16,23 +18,46 @@ int main(int argc, char *argv[]) {
   options.add_options()
   ("n,nnfFile", "NNF equation file path",cxxopts::value<StringList>())
   ("c,cnfFile", "CNF equation file path", cxxopts::value<StringList>())
+  ("i,icnfFile", "Incremental CNF file path, solved at each assumption line",cxxopts::value<StringList>())
   ("o,outFile", "Output file name",cxxopts::value<string>())
   ("v,verbose", "Output formulas",cxxopts::value<bool>()->default_value("false"))
+  ("m,mode", "Search engine: cdcl or dpll",cxxopts::value<string>()->default_value("cdcl"))
+  ("d,decide", "CDCL decision heuristic: alternate, vsids, vmtf or static",cxxopts::value<string>()->default_value("alternate"))
+  ("r,restart", "CDCL restart policy: mode, glucose, luby or none",cxxopts::value<string>()->default_value("mode"))
+  ("luby-unit", "Conflicts per Luby restart unit",cxxopts::value<unsigned>()->default_value("100"))
+  ("no-reuse-trail", "Always restart from the root level",cxxopts::value<bool>()->default_value("false"))
+  ("no-minimize", "Keep learnt clauses unminimized",cxxopts::value<bool>()->default_value("false"))
+  ("no-shrink", "Do not shrink learnt clauses through binary implications",cxxopts::value<bool>()->default_value("false"))
+  ("no-subsume", "Skip subsumption and strengthening",cxxopts::value<bool>()->default_value("false"))
+  ("no-eliminate", "Skip bounded variable elimination",cxxopts::value<bool>()->default_value("false"))
+  ("no-factor", "Skip bounded variable addition",cxxopts::value<bool>()->default_value("false"))
+  ("no-unhide", "Skip hidden tautology and hidden literal elimination",cxxopts::value<bool>()->default_value("false"))
+  ("no-gates", "Eliminate variables without gate detection",cxxopts::value<bool>()->default_value("false"))
+  ("no-block", "Skip blocked and covered clause elimination",cxxopts::value<bool>()->default_value("false"))
+  ("no-probe", "Skip failed literal probing",cxxopts::value<bool>()->default_value("false"))
+  ("no-substitute", "Skip equivalent literal substitution",cxxopts::value<bool>()->default_value("false"))
+  ("no-vivify", "Skip clause vivification",cxxopts::value<bool>()->default_value("false"))
+  ("mus", "Print a minimal unsatisfiable subset of each unsatisfiable CNF file",cxxopts::value<bool>()->default_value("false"))
+  ("s,stats", "Print search statistics",cxxopts::value<bool>()->default_value("false"))
   ("h,help", "Print usage");
   // clang-format on
 
   auto result = options.parse(argc, argv);
 
   bool verbose = result["verbose"].as<bool>();
+  bool stats = result["stats"].as<bool>();
+  bool mus = result["mus"].as<bool>();
   string outFile;
   StringList nnfList;
   StringList cnfList;
+  StringList icnfList;
 
   if (result.count("outFile")) { outFile = result["outFile"].as<string>(); }
   if (result.count("nnfFile")) { nnfList = result["nnfFile"].as<StringList>(); }
   if (result.count("cnfFile")) { cnfList = result["cnfFile"].as<StringList>(); }
+  if (result.count("icnfFile")) { icnfList = result["icnfFile"].as<StringList>(); }
 
-  if (result.count("help") || (nnfList.empty() && cnfList.empty())) {
+  if (result.count("help") || (nnfList.empty() && cnfList.empty() && icnfList.empty())) {
     std::cout << options.help() << std::endl;
     return 0;
   }
@@ -43,11 +68,74 @@ int main(int argc, char *argv[]) {
     throw new invalid_argument("Could not open file");
   }
 
+  vasSAT::SolverOptions opts;
+  string mode = result["mode"].as<string>();
+  if (mode == "dpll") opts.mode = vasSAT::SearchMode::DPLL;
+  else if (mode != "cdcl") {
+    std::cerr << "Unknown search mode: " << mode << "\n";
+    throw new invalid_argument("Unknown search mode");
+  }
+  string decide = result["decide"].as<string>();
+  if (decide == "static") opts.heuristic = vasSAT::DecisionHeuristic::Static;
+  else if (decide == "vsids") opts.heuristic = vasSAT::DecisionHeuristic::VSIDS;
+  else if (decide == "vmtf") opts.heuristic = vasSAT::DecisionHeuristic::VMTF;
+  else if (decide != "alternate") {
+    std::cerr << "Unknown decision heuristic: " << decide << "\n";
+    throw new invalid_argument("Unknown decision heuristic");
+  }
+  string restart = result["restart"].as<string>();
+  if (restart == "glucose") opts.restarts = vasSAT::RestartStrategy::Glucose;
+  else if (restart == "luby") opts.restarts = vasSAT::RestartStrategy::Luby;
+  else if (restart == "none") opts.restarts = vasSAT::RestartStrategy::None;
+  else if (restart != "mode") {
+    std::cerr << "Unknown restart policy: " << restart << "\n";
+    throw new invalid_argument("Unknown restart policy");
+  }
+  opts.lubyUnit = result["luby-unit"].as<unsigned>();
+  opts.reuseTrail = !result["no-reuse-trail"].as<bool>();
+  opts.minimize = !result["no-minimize"].as<bool>();
+  opts.shrink = !result["no-shrink"].as<bool>();
+  if (result["no-subsume"].as<bool>()) {
+    opts.simp.subsume = false;
+    opts.subsume = false;
+  }
+  opts.simp.eliminate = !result["no-eliminate"].as<bool>();
+  opts.simp.block = !result["no-block"].as<bool>();
+  opts.simp.gates = !result["no-gates"].as<bool>();
+  opts.simp.unhide = !result["no-unhide"].as<bool>();
+  opts.simp.factor = !result["no-factor"].as<bool>();
+  opts.probe = !result["no-probe"].as<bool>();
+  opts.substitute = !result["no-substitute"].as<bool>();
+  opts.vivify = !result["no-vivify"].as<bool>();
+
   vasSAT::Parser p;
-  vasSAT::Solver s;
+  vasSAT::Solver s(opts);
 
   for (string &str : cnfList) {
     auto cnf = p.parseCNFFile(str);
+    if (mus) {
+      // the subset in DIMACS, empty for a satisfiable formula
+      vector<unsigned> clauses = s.extractMUS(cnf);
+      if (ofs.is_open()) { ofs << str << " RESULTS:"; }
+      std::cout << str << " RESULTS:";
+      if (clauses.empty()) {
+        if (ofs.is_open()) { ofs << "SAT\n"; }
+        cout << "SAT\n";
+      } else {
+        if (ofs.is_open()) {
+          ofs << "UNSAT\n";
+          cnf->print(ofs, clauses);
+        }
+        cout << "UNSAT\n";
+        cnf->print(std::cout, clauses);
+      }
+      if (stats) {
+        if (ofs.is_open()) s.printStats(ofs);
+        s.printStats(std::cout);
+      }
+      continue;
+    }
+
     bool sat = s.Solve(cnf);
 
     if (verbose) {
@@ -75,6 +163,10 @@ int main(int argc, char *argv[]) {
       if (ofs.is_open()) { ofs << "UNSAT\n"; }
       cout << "UNSAT\n";
     }
+    if (stats) {
+      if (ofs.is_open()) s.printStats(ofs);
+      s.printStats(std::cout);
+    }
   }
 
   for (string &str : nnfList) {
@@ -118,7 +210,74 @@ int main(int argc, char *argv[]) {
       if (ofs.is_open()) { ofs << "UNSAT\n"; }
       cout << "UNSAT\n";
     }
+    if (stats) {
+      if (ofs.is_open()) s.printStats(ofs);
+      s.printStats(std::cout);
+    }
+  }
+  // The incremental format adds clauses as in DIMACS and solves under the
+  // assumptions of each "a <lits> 0" line, through the IPASIR interface
+  for (string &str : icnfList) {
+    ifstream ifs(str);
+    if (!ifs.is_open()) {
+      std::cerr << "Unable to open incremental CNF file: " << str << "\n";
+      throw new invalid_argument("Could not open file");
+    }
+
+    void *solver = ipasir_init();
+    vector<int> assumptions;
+    bool assuming = false;
+    int maxVar = 0;
+    string token;
+    while (ifs >> token) {
+      if (token[0] == 'c' || token[0] == 'p') {
+        getline(ifs, token);
+        continue;
+      }
+      if (token == "a") {
+        assuming = true;
+        continue;
+      }
+      int lit = stoi(token);
+      maxVar = max(maxVar, abs(lit));
+      if (!assuming) {
+        ipasir_add(solver, lit);
+        continue;
+      }
+      if (lit) {
+        assumptions.push_back(lit);
+        continue;
+      }
+
+      for (int assumption : assumptions) {
+        ipasir_assume(solver, assumption);
+      }
+      int res = ipasir_solve(solver);
+      ostringstream out;
+      out << str << " RESULTS:";
+      if (res == 10) {
+        out << "SAT\nv";
+        for (int var = 1; var <= maxVar; var++) {
+          out << " " << ipasir_val(solver, var);
+        }
+        out << " 0\n";
+      } else if (res == 20) {
+        out << "UNSAT\nfailed:";
+        for (int assumption : assumptions) {
+          if (ipasir_failed(solver, assumption)) out << " " << assumption;
+        }
+        out << " 0\n";
+      } else {
+        out << "UNKNOWN\n";
+      }
+      if (ofs.is_open()) ofs << out.str();
+      cout << out.str();
+      assumptions.clear();
+      assuming = false;
+    }
+    ipasir_release(solver);
   }
+
   if (ofs.is_open()) ofs.close();
   return 0;
 }
\ No newline at end of file
@@ -7,6 +7,8 @@
 
 namespace vasSAT {
 using Clause = std::vector<unsigned>;
+// stands for no literal where a literal is expected
+constexpr unsigned NoLiteral = ~0u;
 
 class CNFFormula {
   enum class Assignment { Empty, True, False };
@@ -26,6 +28,8 @@ public:
   void printAssignment(std::ostream &os) const;
   void printAssignmentToFile(std::string &str) const;
   void print(std::ostream &os) const;
+  // only the clauses with the given indices
+  void print(std::ostream &os, const std::vector<unsigned> &clauses) const;
   void printToFile(std::string &str) const;
 };
 
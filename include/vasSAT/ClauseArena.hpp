@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace vasSAT {
+
+// offset of a clause in its arena
+using CRef = uint32_t;
+constexpr CRef CRefUndef = ~0u;
+// Binary clauses are not stored in the arena. A literal implied by one has the
+// other literal of the clause, tagged with this bit, as its reason, which
+// limits the arena to 2^31 words
+constexpr CRef CRefBinary = 1u << 31;
+
+enum class ClauseTier { Core, Tier2, Local };
+
+// A clause as it is laid out in the arena: a three word header followed by the
+// literals. It is only ever accessed in place through a ClauseArena
+struct ArenaClause {
+  uint32_t size;
+  uint32_t learnt : 1;
+  // set when the clause takes part in conflict analysis, reset on reduction
+  uint32_t used : 1;
+  uint32_t garbage : 1;
+  // set once the clause was moved by garbage collection, the extra word then
+  // holds the new reference instead of the activity
+  uint32_t reloced : 1;
+  uint32_t tier : 2;
+  // set once vivification tried the clause, reset after all were tried
+  uint32_t vivified : 1;
+  uint32_t lbd : 25;
+  uint32_t extra;
+
+  unsigned *begin() { return reinterpret_cast<unsigned *>(this + 1); }
+  unsigned *end() { return begin() + size; }
+  const unsigned *begin() const {
+    return reinterpret_cast<const unsigned *>(this + 1);
+  }
+  const unsigned *end() const { return begin() + size; }
+  unsigned &operator[](unsigned idx) { return begin()[idx]; }
+  unsigned operator[](unsigned idx) const { return begin()[idx]; }
+
+  ClauseTier getTier() const { return ClauseTier(tier); }
+  void setTier(ClauseTier t) { tier = unsigned(t); }
+
+  float activity() const {
+    float act;
+    std::memcpy(&act, &extra, sizeof(act));
+    return act;
+  }
+  void setActivity(float act) { std::memcpy(&extra, &act, sizeof(act)); }
+};
+
+static_assert(sizeof(ArenaClause) == 3 * sizeof(uint32_t),
+              "clause header must be three words");
+
+// All clauses of the solver live in one flat vector of 32-bit words and are
+// addressed by their offset into it. Deleted clauses are only counted as
+// wasted until the solver compacts the arena by relocating the live clauses
+// into a fresh one
+class ClauseArena {
+private:
+  static constexpr unsigned headerWords = 3;
+
+  std::vector<uint32_t> m_mem;
+  uint64_t m_wasted = 0;
+
+public:
+  ArenaClause &operator[](CRef ref) {
+    return *reinterpret_cast<ArenaClause *>(&m_mem[ref]);
+  }
+  const ArenaClause &operator[](CRef ref) const {
+    return *reinterpret_cast<const ArenaClause *>(&m_mem[ref]);
+  }
+
+  uint64_t size() const { return m_mem.size(); }
+  uint64_t wasted() const { return m_wasted; }
+
+  void clear();
+  void reserve(uint64_t words) { m_mem.reserve(words); }
+
+  CRef alloc(const std::vector<unsigned> &lits, bool learnt);
+  void free(CRef ref);
+  // drops the literals from newSize on, which stay in the arena as waste
+  void shrink(CRef ref, uint32_t newSize);
+
+  // copies the clause into to, unless it was already moved, and updates ref
+  void reloc(CRef &ref, ClauseArena &to);
+  void moveTo(ClauseArena &to);
+};
+} // namespace vasSAT
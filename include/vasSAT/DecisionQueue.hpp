@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "vasSAT/VarHeap.hpp"
+
+namespace vasSAT {
+
+// A decision queue hands out branching candidates in order of priority. The
+// solver skips candidates that are already assigned, so a queue only has to
+// guarantee that every unassigned variable is eventually handed out again
+// once unassigned() has been called for it
+class AbstractDecisionQueue {
+public:
+  virtual void init(unsigned numVars) = 0;
+  // adds the variables up to numVars, which are all unassigned, keeping the
+  // order of the existing ones
+  virtual void resize(unsigned numVars) = 0;
+  // called once per conflict with the variables seen during analysis, while
+  // they are all still assigned
+  virtual void bump(const std::vector<unsigned> &vars) = 0;
+  virtual void unassigned(unsigned var) = 0;
+  virtual bool next(unsigned &var) = 0;
+  // true if a would be handed out before b
+  virtual bool before(unsigned a, unsigned b) const = 0;
+
+  virtual ~AbstractDecisionQueue() = default;
+};
+
+// decides in internal variable index order
+class StaticQueue : public AbstractDecisionQueue {
+private:
+  unsigned m_numVars = 0;
+  unsigned m_next = 0;
+
+public:
+  void init(unsigned numVars) override;
+  void resize(unsigned numVars) override { m_numVars = numVars; }
+  void bump(const std::vector<unsigned> & /*vars*/) override {}
+  void unassigned(unsigned var) override {
+    if (var < m_next) m_next = var;
+  }
+  bool next(unsigned &var) override;
+  bool before(unsigned a, unsigned b) const override { return a < b; }
+};
+
+// EVSIDS: rather than decaying every activity after a conflict we grow the
+// bump increment, which has the same effect on the ordering
+class HeapQueue : public AbstractDecisionQueue {
+private:
+  std::vector<double> m_activity;
+  double m_varInc = 1.0;
+  double m_decay;
+  VarHeap m_heap{m_activity};
+
+public:
+  explicit HeapQueue(double decay) : m_decay(decay) {}
+
+  double activity(unsigned var) const { return m_activity[var]; }
+
+  void init(unsigned numVars) override;
+  void resize(unsigned numVars) override;
+  void bump(const std::vector<unsigned> &vars) override;
+  // assigned variables are skipped lazily when popped and only go back into
+  // the heap once they are unassigned
+  void unassigned(unsigned var) override { m_heap.insert(var); }
+  bool next(unsigned &var) override;
+  bool before(unsigned a, unsigned b) const override {
+    return m_activity[a] > m_activity[b];
+  }
+};
+
+// Variable move-to-front: a doubly linked list ordered by the time each
+// variable was last bumped. Every variable after m_search is assigned, so the
+// search for a decision resumes from there instead of the end of the list
+class VMTFQueue : public AbstractDecisionQueue {
+private:
+  static constexpr unsigned INVALID = ~0u;
+
+  struct Link {
+    unsigned prev;
+    unsigned next;
+  };
+
+  std::vector<Link> m_links;
+  std::vector<uint64_t> m_stamps;
+  unsigned m_first = INVALID;
+  unsigned m_last = INVALID;
+  unsigned m_search = INVALID;
+  uint64_t m_stamp = 0;
+  std::vector<unsigned> m_sorted;
+
+  void dequeue(unsigned var);
+  void enqueue(unsigned var);
+
+public:
+  void init(unsigned numVars) override;
+  void resize(unsigned numVars) override;
+  void bump(const std::vector<unsigned> &vars) override;
+  void unassigned(unsigned var) override {
+    if (m_search == INVALID || m_stamps[var] > m_stamps[m_search])
+      m_search = var;
+  }
+  bool next(unsigned &var) override;
+  bool before(unsigned a, unsigned b) const override {
+    return m_stamps[a] > m_stamps[b];
+  }
+};
+} // namespace vasSAT
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace vasSAT {
+
+// Clauses removed by simplification which a model of the simplified formula
+// does not have to satisfy, each with a witness literal of the clause. Going
+// through them backwards and making the witness true whenever its clause is
+// not satisfied turns that model into a model of the original formula
+class ExtensionStack {
+private:
+  std::vector<unsigned> m_lits;
+  // per clause, its witness and the index of its first literal in m_lits
+  std::vector<unsigned> m_witnesses;
+  std::vector<unsigned> m_starts;
+
+public:
+  bool empty() const { return m_witnesses.empty(); }
+  void clear();
+  void push(unsigned witness, const std::vector<unsigned> &clause);
+
+  // vals is a full assignment indexed by literal, 1 for true and -1 for false
+  void extend(std::vector<int8_t> &vals) const;
+};
+} // namespace vasSAT
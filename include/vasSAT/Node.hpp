@@ -3,6 +3,7 @@
 #include <assert.h>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
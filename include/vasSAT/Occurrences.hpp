@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace vasSAT {
+
+// One bit per variable modulo 64. If c subsumes or strengthens d then every
+// bit of c's signature is also set in d's, so most pairs are rejected without
+// looking at their literals
+inline uint64_t clauseSignature(const unsigned *lits, unsigned size) {
+  uint64_t sig = 0;
+  for (unsigned k = 0; k < size; k++) {
+    sig |= uint64_t(1) << ((lits[k] / 2) & 63);
+  }
+  return sig;
+}
+
+// Clause indices per literal in compressed sparse row form, filled in two
+// passes over the clauses: every occurrence is counted first, then all lists
+// are laid out back to back in a single vector and filled
+class OccurrenceTable {
+private:
+  // m_starts[lit] is the end of the list of lit until allocate() and its
+  // start afterwards
+  std::vector<unsigned> m_starts;
+  std::vector<unsigned> m_entries;
+  std::vector<unsigned> m_fill;
+
+public:
+  void init(unsigned numLits) {
+    m_starts.assign(numLits + 1, 0);
+    m_entries.clear();
+  }
+  void count(unsigned lit) { m_starts[lit + 1]++; }
+  void allocate() {
+    for (unsigned lit = 1; lit < m_starts.size(); lit++) {
+      m_starts[lit] += m_starts[lit - 1];
+    }
+    m_entries.resize(m_starts.back());
+    m_fill.assign(m_starts.begin(), m_starts.end() - 1);
+  }
+  void add(unsigned lit, unsigned idx) { m_entries[m_fill[lit]++] = idx; }
+
+  const unsigned *begin(unsigned lit) const {
+    return m_entries.data() + m_starts[lit];
+  }
+  const unsigned *end(unsigned lit) const {
+    return m_entries.data() + m_starts[lit + 1];
+  }
+  unsigned size(unsigned lit) const {
+    return m_starts[lit + 1] - m_starts[lit];
+  }
+};
+
+// Result of subsumes() when c neither subsumes nor strengthens d, and when c
+// subsumes d
+constexpr unsigned NotSubsumed = ~0u;
+constexpr unsigned Subsumed = ~1u;
+
+// Checks whether c subsumes d or, if exactly one literal of c occurs negated
+// in d, returns that literal: resolving on it removes its negation from d.
+// marks is indexed by literal and all zero
+inline unsigned subsumes(const unsigned *c, unsigned cSize, const unsigned *d,
+                         unsigned dSize, std::vector<char> &marks) {
+  for (unsigned k = 0; k < dSize; k++) {
+    marks[d[k]] = 1;
+  }
+
+  unsigned result = Subsumed;
+  for (unsigned k = 0; k < cSize; k++) {
+    if (marks[c[k]]) continue;
+    if (marks[c[k] ^ 1] && result == Subsumed) {
+      result = c[k];
+      continue;
+    }
+    result = NotSubsumed;
+    break;
+  }
+
+  for (unsigned k = 0; k < dSize; k++) {
+    marks[d[k]] = 0;
+  }
+  return result;
+}
+} // namespace vasSAT
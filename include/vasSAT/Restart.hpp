@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+
+namespace vasSAT {
+
+// exponential moving average with bias correction, so early values are not
+// dragged towards the zero it starts from
+struct EMA {
+  double value = 0;
+  double biased = 0;
+  double exp = 1;
+  double alpha;
+
+  explicit EMA(double a) : alpha(a) {}
+  void reset() { value = biased = 0, exp = 1; }
+  void update(double y) {
+    biased += alpha * (y - biased);
+    exp *= 1 - alpha;
+    value = biased / (1 - exp);
+  }
+};
+
+class AbstractRestartPolicy {
+public:
+  virtual void init() = 0;
+  // called after every conflict with the LBD of the learnt clause and the
+  // number of assigned variables at the time of the conflict
+  virtual void conflict(unsigned lbd, unsigned trailSize) = 0;
+  virtual bool shouldRestart() = 0;
+  virtual void restarted() = 0;
+  // called when the policy takes over again after a mode switch, which starts
+  // counting conflicts anew without moving on in the schedule
+  virtual void resumed() = 0;
+
+  virtual ~AbstractRestartPolicy() = default;
+};
+
+// restarts after unit * luby(i) conflicts: 1 1 2 1 1 2 4 1 1 2 ...
+class LubyRestart : public AbstractRestartPolicy {
+private:
+  unsigned m_unit;
+  uint64_t m_restarts = 0;
+  uint64_t m_conflicts = 0;
+  uint64_t m_limit = 0;
+
+public:
+  explicit LubyRestart(unsigned unit) : m_unit(unit) {}
+
+  static uint64_t luby(uint64_t i);
+
+  void init() override;
+  void conflict(unsigned /*lbd*/, unsigned /*trailSize*/) override {
+    m_conflicts++;
+  }
+  bool shouldRestart() override { return m_conflicts >= m_limit; }
+  void restarted() override;
+  void resumed() override { m_conflicts = 0; }
+};
+
+// Glucose-style: restart when the recent learnt clauses have a noticeably
+// higher LBD than the long-term average. A restart is blocked when the trail
+// is much longer than usual, since the solver may be close to a model
+class GlucoseRestart : public AbstractRestartPolicy {
+private:
+  EMA m_fastLBD{0.03};
+  EMA m_slowLBD{1e-5};
+  EMA m_trailSize{1.0 / 5000};
+  uint64_t m_conflicts = 0;
+  uint64_t m_totalConflicts = 0;
+  uint64_t m_blocked = 0;
+
+public:
+  static constexpr unsigned minConflicts = 2;
+  static constexpr double margin = 1.1;
+  static constexpr unsigned blockAfter = 10000;
+  static constexpr double blockMargin = 1.4;
+
+  uint64_t blocked() const { return m_blocked; }
+
+  void init() override;
+  void conflict(unsigned lbd, unsigned trailSize) override;
+  bool shouldRestart() override;
+  void restarted() override { m_conflicts = 0; }
+  void resumed() override { m_conflicts = 0; }
+};
+} // namespace vasSAT
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "vasSAT/CNFFormula.hpp"
+#include "vasSAT/Extension.hpp"
+
+namespace vasSAT {
+
+struct SimplifierOptions {
+  // backward subsumption and self-subsuming strengthening, clauses longer
+  // than subsumeClauseSize are not used to subsume others
+  bool subsume = true;
+  unsigned subsumeClauseSize = 100;
+  // bounded variable addition, which factors clauses through fresh variables
+  // before anything else, within factorTicks steps
+  bool factor = true;
+  uint64_t factorTicks = 20000000;
+  // hidden tautology and hidden literal elimination through the timestamps
+  // of a search over the binary implication graph, within unhideTicks steps
+  bool unhide = true;
+  uint64_t unhideTicks = 10000000;
+  // bounded variable elimination: a variable is replaced by the resolvents of
+  // its clauses if there are no more of them than clauses they replace. Only
+  // variables with at most elimOccurrences clauses per polarity are tried and
+  // resolvents longer than elimClauseSize abort the elimination
+  bool eliminate = true;
+  unsigned elimOccurrences = 100;
+  unsigned elimClauseSize = 100;
+  // AND, XOR, ITE and equivalence gates defining a variable restrict its
+  // elimination to the resolvents of gate with non-gate clauses
+  bool gates = true;
+  // blocked clause elimination, only on literals whose negation has at most
+  // blockOccurrences clauses, and covered clause elimination, which stops
+  // extending a clause at coverClauseSize literals
+  bool block = true;
+  unsigned blockOccurrences = 100;
+  bool cover = true;
+  unsigned coverClauseSize = 64;
+};
+
+struct SimplifierStats {
+  uint64_t subsumedClauses = 0;
+  uint64_t strengthenedClauses = 0;
+  uint64_t eliminatedVars = 0;
+  uint64_t gateEliminations = 0;
+  uint64_t addedVars = 0;
+  uint64_t factoredClauses = 0;
+  uint64_t hiddenTautologies = 0;
+  uint64_t hiddenLiterals = 0;
+  uint64_t blockedClauses = 0;
+  uint64_t coveredClauses = 0;
+  uint64_t removedClauses = 0;
+  uint64_t units = 0;
+};
+
+// Simplifies the irredundant clauses of the solver at the root level, kept as
+// plain literal vectors with occurrence lists. Clauses that a model may stop
+// satisfying go onto the extension stack, and new units are kept separately
+// so the solver can assign them
+class Simplifier {
+private:
+  const SimplifierOptions &m_opts;
+  SimplifierStats m_stats;
+
+  std::vector<Clause> m_clauses;
+  std::vector<char> m_removed;
+  // indexed by literal. Removed clauses are only dropped when a list is
+  // cleaned
+  std::vector<std::vector<unsigned>> m_occurs;
+  // root level values, indexed by literal
+  std::vector<int8_t> m_vals;
+  std::vector<unsigned> m_units;
+  unsigned m_propagated = 0;
+  bool m_unsat = false;
+  // clause visits, the passes stop once they reach the limit
+  uint64_t m_ticks = 0;
+  uint64_t m_tickLimit = UINT64_MAX;
+
+  std::vector<char> &m_eliminated;
+  ExtensionStack &m_extension;
+  std::vector<char> m_marks;
+
+  void assign(unsigned lit);
+  bool propagate();
+  void removeClause(unsigned idx);
+  std::vector<unsigned> &occurrences(unsigned lit);
+  void strengthen(unsigned idx, unsigned lit);
+  bool resolve(const Clause &pos, const Clause &neg, unsigned var,
+               Clause &resolvent);
+  unsigned findTernary(unsigned a, unsigned b, unsigned c);
+  bool findAnd(unsigned out, std::vector<unsigned> &gate);
+  bool findXor(unsigned var, std::vector<unsigned> &gate);
+  bool findIte(unsigned var, std::vector<unsigned> &gate);
+  bool findGate(unsigned var, std::vector<unsigned> &gate);
+  bool eliminateVar(unsigned var, std::vector<unsigned> &touched);
+  unsigned newVariable();
+  bool stamp(std::vector<unsigned> &discovered, std::vector<unsigned> &finished,
+             uint64_t limit);
+  bool blocked(unsigned idx, unsigned lit);
+  bool cover(unsigned idx);
+
+public:
+  Simplifier(const SimplifierOptions &opts, const std::vector<int8_t> &vals,
+             std::vector<char> &eliminated, ExtensionStack &extension);
+
+  // sorts the clause and drops duplicate and root-false literals
+  void addClause(const Clause &clause);
+
+  void factor();
+  void unhide();
+  void subsume();
+  void block();
+  void eliminate();
+
+  void setTickLimit(uint64_t limit) { m_tickLimit = limit; }
+  uint64_t ticks() const { return m_ticks; }
+  bool unsat() const { return m_unsat; }
+  const SimplifierStats &getStats() const { return m_stats; }
+  // literals assigned at the root level by the simplifier
+  const std::vector<unsigned> &units() const { return m_units; }
+  // moves the remaining clauses into out
+  void collect(std::vector<Clause> &out);
+};
+} // namespace vasSAT
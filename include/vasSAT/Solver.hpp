@@ -1,23 +1,429 @@
 #pragma once
-#include <stack>
+#include <array>
+#include <cstdint>
+#include <functional>
 
 #include "vasSAT/CNFFormula.hpp"
+#include "vasSAT/ClauseArena.hpp"
+#include "vasSAT/DecisionQueue.hpp"
+#include "vasSAT/Extension.hpp"
 #include "vasSAT/Node.hpp"
+#include "vasSAT/Restart.hpp"
+#include "vasSAT/Simplifier.hpp"
 
 namespace vasSAT {
-enum class Assignment;
+
+enum class SearchMode { DPLL, CDCL };
+// Alternating starts in focused mode (VMTF) and switches between it and
+// stable mode (VSIDS) on a geometrically growing conflict schedule
+enum class DecisionHeuristic { Static, VSIDS, VMTF, Alternating };
+// ByMode restarts frequently (Glucose) in focused mode and rarely (Luby with
+// a large unit) in stable mode
+enum class RestartStrategy { None, Luby, Glucose, ByMode };
+// Unknown when the search was terminated before it reached a result
+enum class SolveResult { Unknown, Sat, Unsat };
+// the inprocessing passes, in the order they run when due at the same time
+enum class Pass { Probe, Subsume, Vivify, Eliminate };
+constexpr unsigned NumPasses = 4;
+
+struct SolverOptions {
+  SearchMode mode = SearchMode::CDCL;
+  // decision heuristic used by the CDCL engine, DPLL always decides in
+  // variable order
+  DecisionHeuristic heuristic = DecisionHeuristic::Alternating;
+  double varDecay = 0.95;
+  unsigned modeSwitchConflicts = 1000;
+  double modeSwitchGrowth = 2.0;
+
+  // polarity tried first for a variable that has never been assigned
+  bool initialPhase = false;
+  bool phaseSaving = true;
+  // in stable mode, decide towards the longest conflict-free trail seen since
+  // the last rephase rather than the last assigned polarity
+  bool targetPhases = true;
+  // rephasing happens every rephaseConflicts * n conflicts for the n-th time
+  unsigned rephaseConflicts = 1000;
+  uint64_t seed = 0;
+
+  RestartStrategy restarts = RestartStrategy::ByMode;
+  unsigned lubyUnit = 100;
+  unsigned stableLubyUnit = 1024;
+  // on restart, keep the decision levels whose decisions would be taken again
+  // before the next candidate of the decision queue
+  bool reuseTrail = true;
+
+  // learnt clauses with an LBD up to coreLBD are kept forever, those up to
+  // tier2LBD as long as they keep being used and the rest are halved on every
+  // reduction, which happens every reduceConflicts + n * reduceIncrement
+  // conflicts
+  unsigned coreLBD = 2;
+  unsigned tier2LBD = 6;
+  unsigned reduceConflicts = 2000;
+  unsigned reduceIncrement = 300;
+  double clauseDecay = 0.999;
+  // remove learnt clause literals implied by the other ones, and replace the
+  // literals of a decision level by one literal implying them all through
+  // binary clauses
+  bool minimize = true;
+  bool shrink = true;
+  // the clause arena is compacted once this fraction of it is deleted clauses
+  double garbageFraction = 0.2;
+
+  // Inprocessing passes run on a geometric conflict schedule: a pass first
+  // runs after its interval and the interval grows by inprocessGrowth with
+  // every run. A run may spend its effort times the ticks the search used
+  // since its previous run, and at least inprocessMinTicks. Ticks count
+  // clause and watch visits, so the schedule is the same on every machine
+  double inprocessGrowth = 1.2;
+  uint64_t inprocessMinTicks = 100000;
+
+  // subsumption and strengthening of the learnt clauses by the other clauses
+  // at the root level
+  bool subsume = true;
+  unsigned subsumeInterval = 4000;
+  double subsumeEffort = 0.05;
+  // equivalent literal substitution on the strongly connected components of
+  // the binary implication graph, then failed literal probing on its roots.
+  // Before the search probing may spend preprocessTicks
+  bool probe = true;
+  bool hyperBinary = true;
+  bool substitute = true;
+  unsigned probeInterval = 5000;
+  double probeEffort = 0.1;
+  uint64_t preprocessTicks = 2000000;
+  // vivification of the learnt clauses outside the local tier and of the
+  // irredundant clauses, each with half the budget
+  bool vivify = true;
+  unsigned vivifyInterval = 2000;
+  double vivifyEffort = 0.1;
+  // the root level simplification below, which runs without a budget before
+  // the search
+  unsigned eliminateInterval = 20000;
+  double eliminateEffort = 0.05;
+
+  // root level simplification of the irredundant clauses, before the search
+  // and as the eliminate pass during it
+  SimplifierOptions simp;
+};
+
+struct PassStats {
+  uint64_t calls = 0;
+  uint64_t ticks = 0;
+  double seconds = 0;
+  // clauses, binary and learnt ones included, and active variables less
+  // after the pass than before it
+  int64_t removedClauses = 0;
+  int64_t removedVars = 0;
+};
+
+struct SolverStats {
+  uint64_t decisions = 0;
+  uint64_t propagations = 0;
+  uint64_t conflicts = 0;
+  uint64_t modeSwitches = 0;
+  uint64_t rephases = 0;
+  uint64_t restarts = 0;
+  uint64_t reusedTrails = 0;
+  uint64_t blockedRestarts = 0;
+  uint64_t reductions = 0;
+  uint64_t learntClauses = 0;
+  uint64_t minimizedLiterals = 0;
+  uint64_t shrunkLiterals = 0;
+  uint64_t deletedClauses = 0;
+  uint64_t garbageCollections = 0;
+  uint64_t subsumedClauses = 0;
+  uint64_t strengthenedClauses = 0;
+  uint64_t eliminatedVars = 0;
+  uint64_t gateEliminations = 0;
+  uint64_t addedVars = 0;
+  uint64_t factoredClauses = 0;
+  uint64_t hiddenTautologies = 0;
+  uint64_t hiddenLiterals = 0;
+  uint64_t blockedClauses = 0;
+  uint64_t coveredClauses = 0;
+  uint64_t failedLiterals = 0;
+  uint64_t probeUnits = 0;
+  uint64_t hyperBinaries = 0;
+  uint64_t substitutedVars = 0;
+  uint64_t vivifiedClauses = 0;
+  uint64_t vivifiedLiterals = 0;
+  uint64_t musSolves = 0;
+  uint64_t musRotations = 0;
+  std::array<PassStats, NumPasses> passes;
+};
 
 class Solver {
-  struct DecisionData;
-  using VarToClauseMap = std::unordered_map<int, std::vector<Clause *>>;
+  // Values of literals. Both literals of a variable are stored, so the value
+  // of a literal is a single load and a negated literal needs no decoding
+  static constexpr int8_t ValTrue = 1;
+  static constexpr int8_t ValFalse = -1;
+  static constexpr int8_t ValUnassigned = 0;
+
+  // a clause watching a literal is only visited once that literal becomes
+  // false. The blocker is another literal of the clause: if it is already true
+  // the clause is satisfied and we never have to touch the clause itself
+  struct Watch {
+    CRef cref;
+    unsigned blocker;
+  };
+  using WatchList = std::vector<Watch>;
 
 private:
-  void initVtcMap(VarToClauseMap &vtcMap,
-                  const std::unique_ptr<CNFFormula> &F) const;
+  SolverOptions m_opts;
+  SolverStats m_stats;
+
+  unsigned m_numVars = 0;
+  // indexed by literal
+  std::vector<int8_t> m_vals;
+  ClauseArena m_arena;
+  std::vector<CRef> m_clauses;
+  std::vector<CRef> m_learnts;
+  // indexed by literal
+  std::vector<WatchList> m_watches;
+  // binary clauses only exist here: for each literal, the literals implied
+  // once it becomes false
+  std::vector<std::vector<unsigned>> m_binaries;
+  // the falsified literal of the binary clause propagate() last returned
+  unsigned m_binaryConflict = 0;
+  // watch lists that may still hold watches of deleted clauses
+  std::vector<unsigned> m_dirtyWatches;
+  std::vector<char> m_isDirty;
+  std::vector<unsigned> m_units;
+  bool m_emptyClause = false;
+
+  // variables removed by simplification are never decided on, their values
+  // are restored from the extension stack once a model is found
+  std::vector<char> m_eliminated;
+  ExtensionStack m_extension;
 
-  bool DPLL(VarToClauseMap &vtcMap, std::unique_ptr<CNFFormula> &F) const;
+  // Search state shared by DPLL and CDCL. The trail holds assigned literals in
+  // assignment order and m_trailLim holds the trail index at which each
+  // decision level starts. Everything behind m_qhead is still to be propagated
+  std::vector<unsigned> m_trail;
+  std::vector<unsigned> m_trailLim;
+  unsigned m_qhead = 0;
+  // watch list entries visited by propagation, the measure of effort given
+  // to inprocessing passes
+  uint64_t m_ticks = 0;
+  // per variable, only meaningful while it is assigned. The reason is
+  // CRefUndef for decisions and units and a CRefBinary tagged literal for
+  // binary clauses
+  std::vector<unsigned> m_level;
+  std::vector<CRef> m_reason;
+  std::vector<unsigned> m_trailPos;
+  std::vector<char> m_seen;
+  std::vector<unsigned> m_bumped;
+  // variables marked in m_seen by minimization that analyze has to reset
+  std::vector<unsigned> m_analyzeClear;
+  std::vector<unsigned> m_analyzeStack;
+
+  StaticQueue m_staticQueue;
+  HeapQueue m_heapQueue{m_opts.varDecay};
+  VMTFQueue m_vmtfQueue;
+  AbstractDecisionQueue *m_queue = nullptr;
+  bool m_stable = false;
+  uint64_t m_switchInterval = 0;
+  uint64_t m_nextSwitch = 0;
+
+  // polarity of each variable, 1 for true
+  std::vector<char> m_savedPhase;
+  std::vector<char> m_targetPhase;
+  std::vector<char> m_bestPhase;
+  unsigned m_targetAssigned = 0;
+  unsigned m_bestAssigned = 0;
+  uint64_t m_nextRephase = 0;
+  uint64_t m_random = 0;
+
+  LubyRestart m_luby{m_opts.lubyUnit};
+  LubyRestart m_stableLuby{m_opts.stableLubyUnit};
+  GlucoseRestart m_glucose;
+  AbstractRestartPolicy *m_restart = nullptr;
+  std::vector<uint64_t> m_levelStamp;
+  uint64_t m_lbdStamp = 0;
+
+  // when each inprocessing pass runs next, and the search ticks at its
+  // previous run
+  struct Schedule {
+    bool enabled;
+    double interval;
+    double effort;
+    uint64_t next;
+    uint64_t searchTicks;
+  };
+  std::array<Schedule, NumPasses> m_schedule;
+  // ticks spent outside the search, by preprocessing and inprocessing
+  uint64_t m_inprocessTicks = 0;
+
+  // Incremental interface. Clauses added later may mention any variable, so
+  // no variable is removed and no clause only kept equisatisfiable: variable
+  // elimination and addition, blocked and covered clause elimination and
+  // equivalent literal substitution are off
+  bool m_incremental = false;
+  bool m_preprocessed = false;
+  // internal variable + 1 of each DIMACS variable, 0 while it is unused,
+  // and the DIMACS variable of each internal one, 0 for selectors and the
+  // variables factoring adds
+  std::vector<unsigned> m_internalVars;
+  std::vector<int> m_externalVars;
+  // decided in order before any other variable, and cleared by every solve
+  std::vector<unsigned> m_assumptions;
+  // the assumptions, selectors included, the final conflict analysis of the
+  // last unsatisfiable solve found
+  std::vector<unsigned> m_failed;
+  // indexed by literal, whether it is one of them
+  std::vector<char> m_isFailed;
+  // by clause ID, the literal each tracked clause is guarded by. Solving
+  // assumes those of the active ones, so the failed ones make up the core
+  std::vector<unsigned> m_selectors;
+  // Excluded only lasts for the next solve
+  enum class Tracked : char { Active, Excluded, Dropped };
+  std::vector<Tracked> m_tracked;
+  // indexed by literal, the assignment of the last satisfiable solve
+  std::vector<int8_t> m_model;
+  std::function<bool()> m_terminate;
+  std::function<void(const std::vector<int> &)> m_learnCallback;
+  unsigned m_learnMaxLength = 0;
+  // probing resumes from this root in the next round
+  unsigned m_probeNext = 0;
+
+  double m_claInc = 1.0;
+  uint64_t m_reduceInterval = 0;
+  uint64_t m_nextReduce = 0;
+
+  void initWatches(const std::vector<Clause> &clauses);
+  static bool isBinary(CRef reason) {
+    return reason != CRefUndef && (reason & CRefBinary);
+  }
+
+  int8_t value(unsigned lit) const { return m_vals[lit]; }
+  void assign(unsigned lit) {
+    m_vals[lit] = ValTrue;
+    m_vals[lit ^ 1] = ValFalse;
+  }
+  void unassign(unsigned lit) { m_vals[lit] = m_vals[lit ^ 1] = ValUnassigned; }
+  unsigned decisionLevel() const { return m_trailLim.size(); }
+  void enqueue(unsigned lit, CRef reason);
+  CRef propagate();
+  void analyze(CRef conflict, std::vector<unsigned> &learnt,
+               unsigned &btLevel);
+  // one bit per decision level modulo 32
+  uint32_t abstractLevel(unsigned var) const {
+    return 1u << (m_level[var] & 31);
+  }
+  void minimize(std::vector<unsigned> &learnt);
+  bool redundant(unsigned lit, uint32_t levels);
+  void shrink(std::vector<unsigned> &learnt);
+  unsigned shrinkLevel(unsigned level, unsigned open, unsigned pos);
+  void backtrack(unsigned level, bool savePhases = true);
+  void learn(const std::vector<unsigned> &learnt, unsigned lbd);
+  void initQueues();
+  void switchMode();
+  bool pickBranchVar(unsigned &var);
+  unsigned decisionLit(unsigned var) const;
+  void initPhases();
+  void updatePhases(unsigned assigned);
+  void rephase();
+  uint64_t nextRandom();
+
+  unsigned computeLBD(const unsigned *lits, unsigned size);
+  void initRestarts();
+  void selectRestartPolicy();
+  unsigned reuseTrailLevel();
+  void restart();
+
+  ClauseTier tierFor(unsigned lbd) const;
+  void bumpClause(ArenaClause &clause);
+  bool locked(CRef cref) const;
+  void deleteClause(CRef cref);
+  void cleanWatches();
+  void reduceDB();
+  void collectGarbage();
+
+  bool factor(const std::vector<Clause> &clauses, std::vector<Clause> &out);
+  bool simplify(uint64_t budget);
+  bool replaceClauses(std::vector<Clause> &clauses);
+  bool rebuildWatches();
+  bool subsumeLearnts(uint64_t budget);
+  bool findEquivalences(std::vector<unsigned> &repr);
+  bool substitute();
+  void detachClause(CRef cref);
+  bool vivifyClause(CRef cref, const std::vector<unsigned> &lits);
+  bool vivifyClauses(std::vector<CRef> &crefs, bool learnt, uint64_t budget);
+  bool vivify(uint64_t budget);
+  bool probe(uint64_t budget);
+  bool probeLiteral(unsigned lit);
+  void hyperBinaryResolve();
+  void extendModel();
+  void initIncremental();
+  void resizeVars(unsigned numVars);
+  unsigned newVar();
+  // maps a DIMACS literal to an internal one, creating its variable
+  unsigned importLit(int lit);
+  // NoLiteral if the DIMACS variable was never used
+  unsigned findLit(int lit) const;
+  // 0 for a literal without a DIMACS variable
+  int exportLit(unsigned lit) const;
+  void addInternalClause(Clause &clause);
+  void analyzeFinal(unsigned lit);
+  uint64_t countClauses() const;
+  unsigned countActiveVars() const;
+  void initInprocessing();
+  bool runPass(Pass pass, uint64_t budget);
+  bool inprocess();
+
+  bool initSearch();
+  bool DPLL();
+  SolveResult CDCL();
 
 public:
-  bool Solve(std::unique_ptr<CNFFormula> &F) const;
+  Solver() = default;
+  explicit Solver(const SolverOptions &opts) : m_opts(opts) {}
+
+  bool Solve(std::unique_ptr<CNFFormula> &F);
+
+  // Incremental solving on one formula, which only ever grows. Literals are
+  // DIMACS integers, and learnt clauses, heuristics and root level
+  // simplifications are kept from one solve to the next. The incremental
+  // interface always searches with CDCL
+  void addClause(const std::vector<int> &lits);
+  // assumed true for the next solve only
+  void assume(int lit);
+  SolveResult solve();
+  // after a satisfiable solve, lit if it is true and -lit if it is false
+  int val(int lit) const;
+  // after an unsatisfiable solve, whether the assumption lit was needed to
+  // show it. No assumption is if the formula itself is unsatisfiable
+  bool failed(int lit) const;
+  // the failed assumptions, in the order they were assumed
+  std::vector<int> failedAssumptions() const;
+  // Adds a clause which is tracked by the returned ID, counting from 0. The
+  // clause is guarded by a selector variable of its own which solves assume
+  // while the clause is active, so an unsatisfiable solve also tells which
+  // tracked clauses it needed
+  unsigned addTrackedClause(const std::vector<int> &lits);
+  // after an unsatisfiable solve, the IDs of the tracked clauses in its core
+  std::vector<unsigned> coreClauses() const;
+  // leaves the tracked clause out of the next solve only
+  void excludeClause(unsigned id);
+  // removes the tracked clause for good
+  void dropClause(unsigned id);
+  // Indices of the clauses of an unsatisfiable F forming a minimal
+  // unsatisfiable subset, found with the incremental interface. Empty if F
+  // is satisfiable
+  std::vector<unsigned> extractMUS(const std::unique_ptr<CNFFormula> &F);
+  // polled once per conflict, the search stops with Unknown once it is true
+  void setTerminate(std::function<bool()> terminate) {
+    m_terminate = std::move(terminate);
+  }
+  // called with every learnt clause of at most maxLength literals over
+  // DIMACS variables only
+  void setLearn(unsigned maxLength,
+                std::function<void(const std::vector<int> &)> learn) {
+    m_learnMaxLength = maxLength;
+    m_learnCallback = std::move(learn);
+  }
+
+  const SolverStats &getStats() const { return m_stats; }
+  void printStats(std::ostream &os) const;
 };
-} // namespace vasSAT
\ No newline at end of file
+} // namespace vasSAT
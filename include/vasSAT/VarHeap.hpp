@@ -0,0 +1,40 @@
+#pragma once
+
+#include <vector>
+
+namespace vasSAT {
+
+// Binary max-heap of variables ordered by an external activity vector. Each
+// variable's position is tracked so a bumped variable can be sifted up in
+// O(log n) without searching for it
+class VarHeap {
+private:
+  const std::vector<double> &m_activity;
+  std::vector<unsigned> m_heap;
+  // position of each variable in m_heap, -1 if it is not in the heap
+  std::vector<int> m_indices;
+
+  bool less(unsigned a, unsigned b) const {
+    return m_activity[a] < m_activity[b];
+  }
+  void siftUp(unsigned idx);
+  void siftDown(unsigned idx);
+
+public:
+  explicit VarHeap(const std::vector<double> &activity)
+      : m_activity(activity) {}
+
+  bool empty() const { return m_heap.empty(); }
+  unsigned size() const { return m_heap.size(); }
+  bool contains(unsigned var) const {
+    return var < m_indices.size() && m_indices[var] >= 0;
+  }
+  unsigned top() const { return m_heap[0]; }
+
+  void clear();
+  void insert(unsigned var);
+  // restores the heap property after the activity of var was increased
+  void increase(unsigned var);
+  unsigned pop();
+};
+} // namespace vasSAT
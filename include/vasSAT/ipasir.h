@@ -0,0 +1,26 @@
+#pragma once
+
+// The IPASIR interface for incremental SAT solvers, implemented on top of
+// vasSAT::Solver. A clause is added one literal at a time and ends with 0.
+// ipasir_solve returns 10 for satisfiable, 20 for unsatisfiable and 0 when
+// it was terminated
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+const char *ipasir_signature();
+void *ipasir_init();
+void ipasir_release(void *solver);
+void ipasir_add(void *solver, int lit_or_zero);
+void ipasir_assume(void *solver, int lit);
+int ipasir_solve(void *solver);
+int ipasir_val(void *solver, int lit);
+int ipasir_failed(void *solver, int lit);
+void ipasir_set_terminate(void *solver, void *data,
+                          int (*terminate)(void *data));
+void ipasir_set_learn(void *solver, void *data, int max_length,
+                      void (*learn)(void *data, int *clause));
+
+#ifdef __cplusplus
+}
+#endif
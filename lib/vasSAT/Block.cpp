@@ -0,0 +1,166 @@
+#include "vasSAT/Simplifier.hpp"
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+namespace vasSAT {
+
+// Whether the clause is blocked on lit: every resolvent with a clause of the
+// negation of lit is a tautology
+bool Simplifier::blocked(unsigned idx, unsigned lit) {
+  const Clause &clause = m_clauses[idx];
+  for (unsigned other : clause) {
+    m_marks[other] = 1;
+  }
+
+  bool result = true;
+  for (unsigned d : occurrences(lit ^ 1)) {
+    m_ticks += m_clauses[d].size();
+    bool tautology = false;
+    for (unsigned other : m_clauses[d]) {
+      if (other != (lit ^ 1) && m_marks[other ^ 1]) {
+        tautology = true;
+        break;
+      }
+    }
+    if (!tautology) {
+      result = false;
+      break;
+    }
+  }
+
+  for (unsigned other : clause) {
+    m_marks[other] = 0;
+  }
+  return result;
+}
+
+// Covered literal addition until the clause is blocked or nothing can be
+// added. The literals every non-tautological resolvent on a literal of the
+// clause has in common are added to it, which keeps the formula satisfiable
+// but not equivalent: each extended clause before an addition goes onto the
+// extension stack with the literal it was extended on, and the final blocked
+// clause on top of them, so they are replayed from the blocked one down to
+// the original clause
+bool Simplifier::cover(unsigned idx) {
+  Clause covered = m_clauses[idx];
+  for (unsigned lit : covered) {
+    m_marks[lit] = 1;
+  }
+
+  // witness and clause size of each extended clause
+  std::vector<std::pair<unsigned, unsigned>> steps;
+  Clause added;
+  unsigned blocking = NoLiteral;
+  for (unsigned k = 0; k < covered.size() && blocking == NoLiteral; k++) {
+    unsigned lit = covered[k];
+    auto &negs = occurrences(lit ^ 1);
+    if (negs.size() > m_opts.blockOccurrences) continue;
+
+    bool first = true;
+    added.clear();
+    for (unsigned d : negs) {
+      const Clause &other = m_clauses[d];
+      m_ticks += other.size();
+      bool tautology = false;
+      for (unsigned o : other) {
+        if (o != (lit ^ 1) && (m_marks[o ^ 1] & 1)) {
+          tautology = true;
+          break;
+        }
+      }
+      if (tautology) continue;
+
+      if (first) {
+        for (unsigned o : other) {
+          if (o != (lit ^ 1) && !m_marks[o]) added.push_back(o);
+        }
+        first = false;
+      } else {
+        for (unsigned o : other) {
+          m_marks[o] |= 2;
+        }
+        auto missing = [&](unsigned o) { return !(m_marks[o] & 2); };
+        added.erase(std::remove_if(added.begin(), added.end(), missing),
+                    added.end());
+        for (unsigned o : other) {
+          m_marks[o] &= 1;
+        }
+      }
+      if (added.empty()) break;
+    }
+
+    if (first) {
+      blocking = lit;
+    } else if (!added.empty() &&
+               covered.size() + added.size() <= m_opts.coverClauseSize) {
+      steps.push_back({lit, unsigned(covered.size())});
+      for (unsigned o : added) {
+        m_marks[o] = 1;
+        covered.push_back(o);
+      }
+    }
+  }
+
+  for (unsigned lit : covered) {
+    m_marks[lit] = 0;
+  }
+  if (blocking == NoLiteral) return false;
+
+  for (auto [witness, size] : steps) {
+    m_extension.push(witness, Clause(covered.begin(), covered.begin() + size));
+  }
+  m_extension.push(blocking, covered);
+  return true;
+}
+
+// Blocked clause elimination, then one round of covered clause elimination
+// over the remaining clauses. The literals whose clauses may have become
+// blocked sit in a priority queue, the ones with the fewest clauses of their
+// negation first, as those are the cheapest to check. Removing a clause makes
+// every clause with the negation of one of its literals a new candidate
+void Simplifier::block() {
+  if (!propagate()) return;
+
+  unsigned numLits = m_vals.size();
+  using Entry = std::pair<unsigned, unsigned>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+  std::vector<char> queued(numLits, 0);
+  auto touch = [&](unsigned lit) {
+    if (queued[lit] || m_eliminated[lit / 2] || m_vals[lit]) return;
+    queued[lit] = 1;
+    queue.push({unsigned(m_occurs[lit ^ 1].size()), lit});
+  };
+  for (unsigned lit = 0; lit < numLits; lit++) {
+    touch(lit);
+  }
+  while (!queue.empty() && m_ticks < m_tickLimit) {
+    unsigned lit = queue.top().second;
+    queue.pop();
+    queued[lit] = 0;
+    if (occurrences(lit ^ 1).size() > m_opts.blockOccurrences) continue;
+
+    std::vector<unsigned> candidates = occurrences(lit);
+    for (unsigned idx : candidates) {
+      if (m_removed[idx] || !blocked(idx, lit)) continue;
+      m_extension.push(lit, m_clauses[idx]);
+      m_stats.blockedClauses++;
+      for (unsigned other : m_clauses[idx]) {
+        touch(other ^ 1);
+      }
+      removeClause(idx);
+    }
+  }
+
+  if (!m_opts.cover) return;
+  for (unsigned idx = 0; idx < m_clauses.size() && m_ticks < m_tickLimit;
+       idx++) {
+    if (m_removed[idx] || m_clauses[idx].size() > m_opts.coverClauseSize)
+      continue;
+    if (!cover(idx)) continue;
+    m_stats.coveredClauses++;
+    removeClause(idx);
+  }
+}
+
+} // namespace vasSAT
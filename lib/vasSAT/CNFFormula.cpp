@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <iostream>
@@ -28,18 +29,30 @@ void CNFFormula::addClause(const std::vector<int> &lits) {
 }
 
 void CNFFormula::print(std::ostream &os) const {
+  std::vector<unsigned> clauses(m_clauses.size());
+  for (unsigned idx = 0; idx < clauses.size(); idx++) {
+    clauses[idx] = idx;
+  }
+  print(os, clauses);
+}
+
+void CNFFormula::print(std::ostream &os,
+                       const std::vector<unsigned> &clauses) const {
+  std::vector<unsigned> external(m_vars.size());
+  unsigned maxVar = 0;
+  for (auto &pair : m_vars) {
+    external[pair.second] = pair.first;
+    maxVar = std::max(maxVar, pair.first);
+  }
 
   // print DIMACS Header
-  os << "p cnf " << m_vars.size() << " " << m_clauses.size() << "\n";
+  os << "p cnf " << maxVar << " " << clauses.size() << "\n";
 
   // print clauses
-  for (auto &clause : m_clauses) {
-    for (int var : clause) {
-      for (auto &pair : m_vars) {
-        if (pair.second * 2 == var) os << pair.first << " ";
-        else if (pair.second * 2 + 1 == var)
-          os << "-" << pair.first << " ";
-      }
+  for (unsigned idx : clauses) {
+    for (unsigned lit : m_clauses[idx]) {
+      if (lit % 2) os << "-";
+      os << external[lit / 2] << " ";
     }
     os << "0\n";
   }
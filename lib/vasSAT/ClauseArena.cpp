@@ -0,0 +1,69 @@
+#include <cassert>
+#include <stdexcept>
+
+#include "vasSAT/ClauseArena.hpp"
+
+namespace vasSAT {
+
+void ClauseArena::clear() {
+  m_mem.clear();
+  m_wasted = 0;
+}
+
+CRef ClauseArena::alloc(const std::vector<unsigned> &lits, bool learnt) {
+  uint64_t ref = m_mem.size();
+  if (ref + headerWords + lits.size() >= CRefBinary)
+    throw std::length_error("clause arena exhausted");
+
+  m_mem.resize(ref + headerWords + lits.size());
+  ArenaClause &clause = (*this)[ref];
+  clause.size = lits.size();
+  clause.learnt = learnt;
+  clause.used = 0;
+  clause.garbage = 0;
+  clause.reloced = 0;
+  clause.setTier(ClauseTier::Local);
+  clause.vivified = 0;
+  clause.lbd = 0;
+  clause.setActivity(0);
+  std::copy(lits.begin(), lits.end(), clause.begin());
+  return ref;
+}
+
+void ClauseArena::free(CRef ref) {
+  ArenaClause &clause = (*this)[ref];
+  assert(!clause.garbage);
+  clause.garbage = 1;
+  m_wasted += headerWords + clause.size;
+}
+
+void ClauseArena::shrink(CRef ref, uint32_t newSize) {
+  ArenaClause &clause = (*this)[ref];
+  assert(newSize <= clause.size);
+  m_wasted += clause.size - newSize;
+  clause.size = newSize;
+}
+
+void ClauseArena::reloc(CRef &ref, ClauseArena &to) {
+  ArenaClause &clause = (*this)[ref];
+  if (clause.reloced) {
+    ref = clause.extra;
+    return;
+  }
+
+  uint64_t newRef = to.m_mem.size();
+  to.m_mem.insert(to.m_mem.end(), m_mem.begin() + ref,
+                  m_mem.begin() + ref + headerWords + clause.size);
+  clause.reloced = 1;
+  clause.extra = newRef;
+  ref = newRef;
+}
+
+void ClauseArena::moveTo(ClauseArena &to) {
+  to.m_mem.swap(m_mem);
+  to.m_wasted = m_wasted;
+  m_mem.clear();
+  m_wasted = 0;
+}
+
+} // namespace vasSAT
@@ -0,0 +1,118 @@
+#include <algorithm>
+
+#include "vasSAT/DecisionQueue.hpp"
+
+namespace vasSAT {
+
+void StaticQueue::init(unsigned numVars) {
+  m_numVars = numVars;
+  m_next = 0;
+}
+
+bool StaticQueue::next(unsigned &var) {
+  if (m_next == m_numVars) return false;
+  var = m_next++;
+  return true;
+}
+
+void HeapQueue::init(unsigned numVars) {
+  m_activity.assign(numVars, 0.0);
+  m_varInc = 1.0;
+  m_heap.clear();
+  for (unsigned var = 0; var < numVars; var++) {
+    m_heap.insert(var);
+  }
+}
+
+void HeapQueue::resize(unsigned numVars) {
+  unsigned oldVars = m_activity.size();
+  if (numVars <= oldVars) return;
+  m_activity.resize(numVars, 0.0);
+  for (unsigned var = oldVars; var < numVars; var++) {
+    m_heap.insert(var);
+  }
+}
+
+void HeapQueue::bump(const std::vector<unsigned> &vars) {
+  for (unsigned var : vars) {
+    if ((m_activity[var] += m_varInc) > 1e100) {
+      for (double &activity : m_activity) {
+        activity *= 1e-100;
+      }
+      m_varInc *= 1e-100;
+    }
+    m_heap.increase(var);
+  }
+  m_varInc /= m_decay;
+}
+
+bool HeapQueue::next(unsigned &var) {
+  if (m_heap.empty()) return false;
+  var = m_heap.pop();
+  return true;
+}
+
+void VMTFQueue::dequeue(unsigned var) {
+  Link &link = m_links[var];
+  if (link.prev != INVALID) m_links[link.prev].next = link.next;
+  else m_first = link.next;
+  if (link.next != INVALID) m_links[link.next].prev = link.prev;
+  else m_last = link.prev;
+}
+
+void VMTFQueue::enqueue(unsigned var) {
+  m_links[var] = {m_last, INVALID};
+  if (m_last != INVALID) m_links[m_last].next = var;
+  else m_first = var;
+  m_last = var;
+  m_stamps[var] = ++m_stamp;
+}
+
+void VMTFQueue::init(unsigned numVars) {
+  m_links.assign(numVars, {INVALID, INVALID});
+  m_stamps.assign(numVars, 0);
+  m_first = m_last = INVALID;
+  m_stamp = 0;
+
+  // the front of the queue is the end of the list, so enqueue in reverse to
+  // start out deciding in variable order
+  for (unsigned var = numVars; var > 0; var--) {
+    enqueue(var - 1);
+  }
+  m_search = m_last;
+}
+
+// new variables go to the front, the lowest one first like in init
+void VMTFQueue::resize(unsigned numVars) {
+  unsigned oldVars = m_links.size();
+  if (numVars <= oldVars) return;
+  m_links.resize(numVars, {INVALID, INVALID});
+  m_stamps.resize(numVars, 0);
+  for (unsigned var = numVars; var > oldVars; var--) {
+    enqueue(var - 1);
+  }
+  m_search = m_last;
+}
+
+void VMTFQueue::bump(const std::vector<unsigned> &vars) {
+  // move the variables to the front in their current relative order
+  m_sorted = vars;
+  std::sort(m_sorted.begin(), m_sorted.end(),
+            [&](unsigned a, unsigned b) { return m_stamps[a] < m_stamps[b]; });
+
+  for (unsigned var : m_sorted) {
+    if (var == m_last) continue;
+    if (var == m_search) m_search = m_links[var].prev;
+    dequeue(var);
+    enqueue(var);
+  }
+}
+
+bool VMTFQueue::next(unsigned &var) {
+  if (m_search == INVALID) return false;
+  var = m_search;
+  m_search = m_links[var].prev;
+  return true;
+}
+
+} // namespace vasSAT
@@ -0,0 +1,131 @@
+#include "vasSAT/Simplifier.hpp"
+#include <algorithm>
+
+namespace vasSAT {
+
+// resolvent of pos and neg on var, false if it is a tautology
+bool Simplifier::resolve(const Clause &pos, const Clause &neg, unsigned var,
+                         Clause &resolvent) {
+  resolvent.clear();
+  for (unsigned lit : pos) {
+    if (lit / 2 == var) continue;
+    m_marks[lit] = 1;
+    resolvent.push_back(lit);
+  }
+
+  bool tautology = false;
+  for (unsigned lit : neg) {
+    if (lit / 2 == var || m_marks[lit]) continue;
+    if (m_marks[lit ^ 1]) {
+      tautology = true;
+      break;
+    }
+    resolvent.push_back(lit);
+  }
+
+  for (unsigned lit : pos) {
+    m_marks[lit] = 0;
+  }
+  return !tautology;
+}
+
+// SatELite-style elimination by clause distribution: the clauses of var are
+// replaced by all their non-tautological resolvents on it, unless there would
+// be more resolvents than clauses. If var is defined by a gate, only the
+// resolvents of gate with non-gate clauses are needed. The removed clauses go
+// onto the extension stack with the literal of var as witness
+bool Simplifier::eliminateVar(unsigned var, std::vector<unsigned> &touched) {
+  auto &pos = occurrences(var * 2);
+  auto &neg = occurrences(var * 2 + 1);
+  if (pos.size() > m_opts.elimOccurrences ||
+      neg.size() > m_opts.elimOccurrences)
+    return false;
+
+  // with a gate only gate clauses are resolved with the other clauses: the
+  // resolvents of two gate clauses are tautologies and those of two other
+  // clauses are implied by the rest
+  std::vector<unsigned> gate;
+  bool gated = m_opts.gates && findGate(var, gate);
+  auto inGate = [&](unsigned idx) {
+    return std::find(gate.begin(), gate.end(), idx) != gate.end();
+  };
+
+  std::vector<Clause> resolvents;
+  Clause resolvent;
+  for (unsigned p : pos) {
+    bool gateClause = gated && inGate(p);
+    for (unsigned n : neg) {
+      if (gated && gateClause == inGate(n)) continue;
+      m_ticks += m_clauses[p].size() + m_clauses[n].size();
+      if (!resolve(m_clauses[p], m_clauses[n], var, resolvent)) continue;
+      if (resolvent.size() > m_opts.elimClauseSize ||
+          resolvents.size() == pos.size() + neg.size())
+        return false;
+      resolvents.push_back(resolvent);
+    }
+  }
+
+  m_eliminated[var] = 1;
+  m_stats.eliminatedVars++;
+  if (gated) m_stats.gateEliminations++;
+  for (unsigned lit = var * 2; lit <= var * 2 + 1; lit++) {
+    for (unsigned idx : m_occurs[lit]) {
+      for (unsigned other : m_clauses[idx]) {
+        touched.push_back(other / 2);
+      }
+      m_extension.push(lit, m_clauses[idx]);
+      removeClause(idx);
+    }
+    m_occurs[lit].clear();
+  }
+
+  for (auto &clause : resolvents) {
+    addClause(clause);
+  }
+  return propagate();
+}
+
+// Tries the variables with the fewest potential resolvents first. Every
+// elimination changes the occurrences of the variables it shares clauses
+// with, so those are tried again in the next round
+void Simplifier::eliminate() {
+  if (!propagate()) return;
+
+  unsigned numVars = m_vals.size() / 2;
+  std::vector<unsigned> candidates;
+  for (unsigned var = 0; var < numVars; var++) {
+    if (!m_eliminated[var] && !m_vals[var * 2]) candidates.push_back(var);
+  }
+
+  std::vector<unsigned> touched;
+  std::vector<char> queued(numVars, 0);
+  std::vector<uint64_t> cost(numVars);
+  while (!candidates.empty()) {
+    for (unsigned var : candidates) {
+      cost[var] = uint64_t(occurrences(var * 2).size()) *
+                  occurrences(var * 2 + 1).size();
+    }
+    std::stable_sort(
+        candidates.begin(), candidates.end(),
+        [&](unsigned a, unsigned b) { return cost[a] < cost[b]; });
+
+    touched.clear();
+    for (unsigned var : candidates) {
+      if (m_ticks >= m_tickLimit) return;
+      if (m_eliminated[var] || m_vals[var * 2]) continue;
+      if (!eliminateVar(var, touched) && m_unsat) return;
+    }
+
+    candidates.clear();
+    for (unsigned var : touched) {
+      if (queued[var] || m_eliminated[var] || m_vals[var * 2]) continue;
+      queued[var] = 1;
+      candidates.push_back(var);
+    }
+    for (unsigned var : candidates) {
+      queued[var] = 0;
+    }
+  }
+}
+
+} // namespace vasSAT
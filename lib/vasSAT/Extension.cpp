@@ -0,0 +1,34 @@
+#include "vasSAT/Extension.hpp"
+
+namespace vasSAT {
+
+void ExtensionStack::clear() {
+  m_lits.clear();
+  m_witnesses.clear();
+  m_starts.clear();
+}
+
+void ExtensionStack::push(unsigned witness,
+                          const std::vector<unsigned> &clause) {
+  m_witnesses.push_back(witness);
+  m_starts.push_back(m_lits.size());
+  m_lits.insert(m_lits.end(), clause.begin(), clause.end());
+}
+
+void ExtensionStack::extend(std::vector<int8_t> &vals) const {
+  unsigned end = m_lits.size();
+  for (unsigned i = m_witnesses.size(); i-- > 0;) {
+    bool satisfied = false;
+    for (unsigned k = m_starts[i]; k < end && !satisfied; k++) {
+      satisfied = vals[m_lits[k]] > 0;
+    }
+    end = m_starts[i];
+    if (satisfied) continue;
+
+    unsigned witness = m_witnesses[i];
+    vals[witness] = 1;
+    vals[witness ^ 1] = -1;
+  }
+}
+
+} // namespace vasSAT
@@ -0,0 +1,180 @@
+#include "vasSAT/Simplifier.hpp"
+#include <algorithm>
+#include <array>
+#include <queue>
+
+namespace vasSAT {
+
+unsigned Simplifier::newVariable() {
+  unsigned var = m_vals.size() / 2;
+  m_vals.resize(m_vals.size() + 2, 0);
+  m_occurs.resize(m_vals.size());
+  m_marks.resize(m_vals.size(), 0);
+  m_eliminated.push_back(0);
+  m_stats.addedVars++;
+  return var;
+}
+
+// Bounded variable addition. The clauses (l r) for every literal l of a set
+// L and every clause r of a set R are replaced by (l -x) for each l and (r x)
+// for each r, where x is a fresh variable, which saves |L||R| - |L| - |R|
+// clauses. Starting from the clauses of one literal, L grows by the literal
+// completing the most of them to such a matrix as long as the saving does.
+// Resolving on x gives back the original clauses, so a model of the new ones
+// is one of the old ones and no extension is needed
+void Simplifier::factor() {
+  if (!propagate()) return;
+
+  uint64_t limit = std::min(m_ticks + m_opts.factorTicks, m_tickLimit);
+  using Entry = std::pair<unsigned, unsigned>;
+  std::priority_queue<Entry> queue;
+  for (unsigned lit = 0; lit < m_vals.size(); lit++) {
+    unsigned count = occurrences(lit).size();
+    if (count > 1 && !m_vals[lit] && !m_eliminated[lit / 2])
+      queue.push({count, lit});
+  }
+
+  // clauses in the matrix being built
+  std::vector<char> used(m_clauses.size(), 0);
+  std::vector<unsigned> counts(m_vals.size(), 0);
+  std::vector<unsigned> next;
+  while (!queue.empty() && m_ticks < limit && !m_unsat) {
+    auto [count, lit] = queue.top();
+    queue.pop();
+    // entries are not updated when clauses go away, only checked here
+    unsigned current = occurrences(lit).size();
+    if (current < 2 || m_vals[lit] || m_eliminated[lit / 2]) continue;
+    if (current < count) {
+      queue.push({current, lit});
+      continue;
+    }
+
+    // rows holds the literals of L and matrix[j][i] is the clause of column j
+    // with the literal of row i, so each column starts with a clause of lit
+    std::vector<unsigned> rows = {lit};
+    std::vector<std::vector<unsigned>> matrix;
+    for (unsigned idx : occurrences(lit)) {
+      matrix.push_back({idx});
+      used[idx] = 1;
+    }
+
+    // clause, column and differing literal of every clause which equals a
+    // clause of lit in all but one literal
+    std::vector<std::array<unsigned, 3>> pairs;
+    while (true) {
+      pairs.clear();
+      for (unsigned j = 0; j < matrix.size(); j++) {
+        const Clause &clause = m_clauses[matrix[j][0]];
+        unsigned min = NoLiteral;
+        for (unsigned other : clause) {
+          if (other == lit) continue;
+          m_marks[other] = 1;
+          if (min == NoLiteral ||
+              m_occurs[other].size() < m_occurs[min].size())
+            min = other;
+        }
+
+        for (unsigned d : occurrences(min)) {
+          const Clause &other = m_clauses[d];
+          m_ticks += other.size();
+          if (used[d] || other.size() != clause.size()) continue;
+          unsigned extra = NoLiteral;
+          bool match = true;
+          for (unsigned o : other) {
+            if (m_marks[o]) continue;
+            match = extra == NoLiteral;
+            extra = o;
+            if (!match) break;
+          }
+          // a clause of lit itself is a duplicate or differs in another
+          // literal
+          if (!match || extra == NoLiteral || extra / 2 == lit / 2) continue;
+          if (counts[extra]++ == 0) next.push_back(extra);
+          pairs.push_back({d, j, extra});
+        }
+
+        for (unsigned other : clause) {
+          m_marks[other] = 0;
+        }
+      }
+
+      unsigned best = NoLiteral;
+      for (unsigned other : next) {
+        if (std::find(rows.begin(), rows.end(), other) != rows.end()) continue;
+        if (best == NoLiteral || counts[other] > counts[best]) best = other;
+      }
+      for (unsigned other : next) {
+        counts[other] = 0;
+      }
+      next.clear();
+      if (best == NoLiteral) break;
+
+      // the first clause with best completing each column, where identical
+      // columns must not share one
+      std::vector<unsigned> match(matrix.size(), NoLiteral);
+      std::vector<unsigned> chosen;
+      for (auto [d, j, extra] : pairs) {
+        if (extra != best || match[j] != NoLiteral || used[d]) continue;
+        match[j] = d;
+        used[d] = 1;
+        chosen.push_back(d);
+      }
+      int64_t numRows = rows.size(), numCols = matrix.size();
+      int64_t saving = numRows * numCols - numRows - numCols;
+      numRows++;
+      numCols = chosen.size();
+      if (numRows * numCols - numRows - numCols <= saving) {
+        for (unsigned d : chosen) {
+          used[d] = 0;
+        }
+        break;
+      }
+
+      std::vector<std::vector<unsigned>> kept;
+      for (unsigned j = 0; j < matrix.size(); j++) {
+        if (match[j] == NoLiteral) {
+          for (unsigned idx : matrix[j]) {
+            used[idx] = 0;
+          }
+          continue;
+        }
+        matrix[j].push_back(match[j]);
+        kept.push_back(std::move(matrix[j]));
+      }
+      rows.push_back(best);
+      matrix.swap(kept);
+    }
+
+    for (auto &column : matrix) {
+      for (unsigned idx : column) {
+        used[idx] = 0;
+      }
+    }
+    int64_t numRows = rows.size(), numCols = matrix.size();
+    if (numRows < 2 || numRows * numCols - numRows - numCols <= 0) continue;
+
+    unsigned var = newVariable();
+    m_stats.factoredClauses += numRows * numCols - numRows - numCols;
+    for (unsigned row : rows) {
+      addClause({row, var * 2 + 1});
+    }
+    for (auto &column : matrix) {
+      Clause rest = {var * 2};
+      for (unsigned other : m_clauses[column[0]]) {
+        if (other != lit) rest.push_back(other);
+      }
+      for (unsigned idx : column) {
+        removeClause(idx);
+      }
+      addClause(rest);
+    }
+    used.resize(m_clauses.size(), 0);
+    counts.resize(m_vals.size(), 0);
+
+    for (unsigned other : {lit, var * 2, var * 2 + 1}) {
+      queue.push({unsigned(occurrences(other).size()), other});
+    }
+  }
+}
+
+} // namespace vasSAT
@@ -0,0 +1,119 @@
+#include "vasSAT/Simplifier.hpp"
+#include <algorithm>
+
+namespace vasSAT {
+
+constexpr unsigned NoClause = ~0u;
+
+// the literal of a ternary clause which is neither a nor b
+static unsigned third(const Clause &clause, unsigned a, unsigned b) {
+  for (unsigned lit : clause) {
+    if (lit != a && lit != b) return lit;
+  }
+  return NoLiteral;
+}
+
+// index of the ternary clause (a b c), searched among the clauses of a. The
+// gate searches walk occurrence lists while calling this, so it leaves them
+// as they are
+unsigned Simplifier::findTernary(unsigned a, unsigned b, unsigned c) {
+  for (unsigned idx : m_occurs[a]) {
+    const Clause &clause = m_clauses[idx];
+    if (m_removed[idx] || clause.size() != 3) continue;
+    if (std::find(clause.begin(), clause.end(), b) != clause.end() &&
+        std::find(clause.begin(), clause.end(), c) != clause.end())
+      return idx;
+  }
+  return NoClause;
+}
+
+// out = AND(l1, ..., lk) as (-out l1) ... (-out lk) (out -l1 ... -lk). With
+// k = 1 this is an equivalence, and an OR gate is an AND gate of -out
+bool Simplifier::findAnd(unsigned out, std::vector<unsigned> &gate) {
+  // the binary clauses (-out l), by l
+  std::vector<std::pair<unsigned, unsigned>> binaries;
+  for (unsigned idx : occurrences(out ^ 1)) {
+    const Clause &clause = m_clauses[idx];
+    if (clause.size() != 2) continue;
+    unsigned other = clause[0] == (out ^ 1) ? clause[1] : clause[0];
+    binaries.push_back({other, idx});
+    m_marks[other] = 1;
+  }
+
+  bool found = false;
+  for (unsigned idx : occurrences(out)) {
+    const Clause &clause = m_clauses[idx];
+    found = std::all_of(clause.begin(), clause.end(), [&](unsigned lit) {
+      return lit == out || m_marks[lit ^ 1];
+    });
+    if (!found) continue;
+
+    gate.push_back(idx);
+    for (auto [other, binary] : binaries) {
+      if (std::find(clause.begin(), clause.end(), other ^ 1) != clause.end())
+        gate.push_back(binary);
+    }
+    break;
+  }
+
+  for (auto [other, binary] : binaries) {
+    m_marks[other] = 0;
+  }
+  return found;
+}
+
+// x = a XOR b as (-x a b) (-x -a -b) (x -a b) (x a -b)
+bool Simplifier::findXor(unsigned var, std::vector<unsigned> &gate) {
+  unsigned x = var * 2;
+  for (unsigned idx : occurrences(x ^ 1)) {
+    const Clause &clause = m_clauses[idx];
+    if (clause.size() != 3) continue;
+    unsigned a = clause[0] == (x ^ 1) ? clause[1] : clause[0];
+    unsigned b = third(clause, x ^ 1, a);
+
+    unsigned clauses[3] = {findTernary(x ^ 1, a ^ 1, b ^ 1),
+                           findTernary(x, a ^ 1, b), findTernary(x, a, b ^ 1)};
+    if (std::count(clauses, clauses + 3, NoClause)) continue;
+    gate.assign({idx, clauses[0], clauses[1], clauses[2]});
+    return true;
+  }
+  return false;
+}
+
+// x = ITE(c, t, e) as (-x -c t) (-x c e) (x -c -t) (x c -e)
+bool Simplifier::findIte(unsigned var, std::vector<unsigned> &gate) {
+  unsigned x = var * 2;
+  for (unsigned idx : occurrences(x ^ 1)) {
+    const Clause &clause = m_clauses[idx];
+    if (clause.size() != 3) continue;
+    unsigned p = clause[0] == (x ^ 1) ? clause[1] : clause[0];
+    unsigned q = third(clause, x ^ 1, p);
+
+    for (auto [c, t] : {std::pair(p ^ 1, q), std::pair(q ^ 1, p)}) {
+      unsigned thenClause = findTernary(x, c ^ 1, t ^ 1);
+      if (thenClause == NoClause) continue;
+      for (unsigned other : m_occurs[x ^ 1]) {
+        const Clause &ternary = m_clauses[other];
+        if (other == idx || m_removed[other] || ternary.size() != 3 ||
+            std::find(ternary.begin(), ternary.end(), c) == ternary.end())
+          continue;
+        unsigned e = third(ternary, x ^ 1, c);
+        unsigned elseClause = findTernary(x, c, e ^ 1);
+        if (elseClause == NoClause) continue;
+        gate.assign({idx, other, thenClause, elseClause});
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// Clauses of var defining it as a function of other variables: an AND gate
+// of either polarity, which covers OR gates and equivalences, a XOR or an ITE
+bool Simplifier::findGate(unsigned var, std::vector<unsigned> &gate) {
+  gate.clear();
+  return findAnd(var * 2, gate) || findAnd(var * 2 + 1, gate) ||
+         findXor(var, gate) || findIte(var, gate);
+}
+
+} // namespace vasSAT
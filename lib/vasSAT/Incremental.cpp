@@ -0,0 +1,294 @@
+#include "vasSAT/Solver.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+
+namespace vasSAT {
+
+// Starts the incremental interface on an empty formula
+void Solver::initIncremental() {
+  m_stats = SolverStats();
+  m_incremental = true;
+  m_preprocessed = false;
+  m_numVars = 0;
+  m_vals.clear();
+  m_eliminated.clear();
+  m_extension.clear();
+  m_internalVars.clear();
+  m_externalVars.clear();
+  m_assumptions.clear();
+  m_failed.clear();
+  m_isFailed.clear();
+  m_selectors.clear();
+  m_tracked.clear();
+  m_model.clear();
+  initWatches({});
+  initSearch();
+}
+
+// Grows every per-variable structure to numVars variables, the new ones
+// unassigned. VMTF queues them at the front as if just bumped, while VSIDS
+// gives them no activity and the static order puts them last
+void Solver::resizeVars(unsigned numVars) {
+  if (numVars <= m_numVars) return;
+  m_numVars = numVars;
+
+  m_vals.resize(numVars * 2, ValUnassigned);
+  m_watches.resize(numVars * 2);
+  m_binaries.resize(numVars * 2);
+  m_isDirty.resize(numVars * 2, 0);
+  m_eliminated.resize(numVars, 0);
+  m_level.resize(numVars, 0);
+  m_reason.resize(numVars, CRefUndef);
+  m_trailPos.resize(numVars, 0);
+  m_seen.resize(numVars, 0);
+  m_savedPhase.resize(numVars, m_opts.initialPhase);
+  m_targetPhase.resize(numVars, m_opts.initialPhase);
+  m_bestPhase.resize(numVars, m_opts.initialPhase);
+  m_levelStamp.resize(numVars + 1, 0);
+
+  m_staticQueue.resize(numVars);
+  m_heapQueue.resize(numVars);
+  m_vmtfQueue.resize(numVars);
+}
+
+unsigned Solver::newVar() {
+  resizeVars(m_numVars + 1);
+  m_externalVars.push_back(0);
+  return m_numVars - 1;
+}
+
+unsigned Solver::importLit(int lit) {
+  unsigned var = std::abs(lit);
+  if (var >= m_internalVars.size()) m_internalVars.resize(var + 1, 0);
+  if (!m_internalVars[var]) {
+    m_internalVars[var] = newVar() + 1;
+    m_externalVars.back() = var;
+  }
+  return (m_internalVars[var] - 1) * 2 + (lit < 0);
+}
+
+unsigned Solver::findLit(int lit) const {
+  unsigned var = std::abs(lit);
+  if (var >= m_internalVars.size() || !m_internalVars[var]) return NoLiteral;
+  return (m_internalVars[var] - 1) * 2 + (lit < 0);
+}
+
+int Solver::exportLit(unsigned lit) const {
+  int var = lit / 2 < m_externalVars.size() ? m_externalVars[lit / 2] : 0;
+  return lit % 2 ? -var : var;
+}
+
+void Solver::addClause(const std::vector<int> &lits) {
+  if (!m_incremental) initIncremental();
+  Clause clause;
+  for (int lit : lits) {
+    if (lit == 0 || lit == INT_MIN) {
+      std::cerr << "Invalid literal in a clause: " << lit << "\n";
+      throw new std::invalid_argument("Invalid literal");
+    }
+    clause.push_back(importLit(lit));
+  }
+  addInternalClause(clause);
+}
+
+unsigned Solver::addTrackedClause(const std::vector<int> &lits) {
+  if (!m_incremental) initIncremental();
+  Clause clause;
+  for (int lit : lits) {
+    if (lit == 0 || lit == INT_MIN) {
+      std::cerr << "Invalid literal in a clause: " << lit << "\n";
+      throw new std::invalid_argument("Invalid literal");
+    }
+    clause.push_back(importLit(lit));
+  }
+  unsigned selector = newVar() * 2;
+  clause.push_back(selector ^ 1);
+  addInternalClause(clause);
+  m_selectors.push_back(selector);
+  m_tracked.push_back(Tracked::Active);
+  return m_selectors.size() - 1;
+}
+
+// Adds the clause at the root level, without its root-false literals and
+// unless it is a tautology or satisfied at the root
+void Solver::addInternalClause(Clause &clause) {
+  backtrack(0);
+  std::sort(clause.begin(), clause.end());
+  clause.erase(std::unique(clause.begin(), clause.end()), clause.end());
+
+  unsigned size = 0;
+  for (unsigned k = 0; k < clause.size(); k++) {
+    unsigned lit = clause[k];
+    if (value(lit) == ValTrue) return;
+    if (k + 1 < clause.size() && clause[k + 1] == (lit ^ 1)) return;
+    if (value(lit) == ValUnassigned) clause[size++] = lit;
+  }
+  clause.resize(size);
+
+  if (clause.empty()) {
+    m_emptyClause = true;
+    return;
+  }
+  if (clause.size() == 1) {
+    enqueue(clause[0], CRefUndef);
+    return;
+  }
+  if (clause.size() == 2) {
+    m_binaries[clause[0]].push_back(clause[1]);
+    m_binaries[clause[1]].push_back(clause[0]);
+    return;
+  }
+  CRef cref = m_arena.alloc(clause, false);
+  m_clauses.push_back(cref);
+  m_watches[clause[0]].push_back({cref, clause[1]});
+  m_watches[clause[1]].push_back({cref, clause[0]});
+}
+
+void Solver::assume(int lit) {
+  if (!m_incremental) initIncremental();
+  if (lit == 0 || lit == INT_MIN) {
+    std::cerr << "Invalid literal as an assumption: " << lit << "\n";
+    throw new std::invalid_argument("Invalid literal");
+  }
+  m_assumptions.push_back(importLit(lit));
+}
+
+// Final conflict analysis for the assumption lit found false. Its negation
+// follows from the assumptions reached by walking the reasons on the trail
+// backwards, which are its decisions, so these and lit fail together
+void Solver::analyzeFinal(unsigned lit) {
+  m_failed.clear();
+  m_failed.push_back(lit);
+  m_isFailed.assign(m_numVars * 2, 0);
+  m_isFailed[lit] = 1;
+  if (m_level[lit / 2] == 0) return;
+
+  m_seen[lit / 2] = 1;
+  for (unsigned i = m_trail.size(); i-- > m_trailLim[0];) {
+    unsigned var = m_trail[i] / 2;
+    if (!m_seen[var]) continue;
+    m_seen[var] = 0;
+
+    CRef reason = m_reason[var];
+    if (reason == CRefUndef) {
+      m_failed.push_back(m_trail[i]);
+      continue;
+    }
+    if (isBinary(reason)) {
+      unsigned other = (reason ^ CRefBinary) / 2;
+      if (m_level[other] > 0) m_seen[other] = 1;
+      continue;
+    }
+    ArenaClause &clause = m_arena[reason];
+    for (unsigned k = 1; k < clause.size; k++) {
+      if (m_level[clause[k] / 2] > 0) m_seen[clause[k] / 2] = 1;
+    }
+  }
+
+  // in the order they were assumed, which lists the selectors last
+  for (unsigned failed : m_failed) {
+    m_isFailed[failed] = 1;
+  }
+  m_failed.clear();
+  for (unsigned assumption : m_assumptions) {
+    if (!m_isFailed[assumption]) continue;
+    m_isFailed[assumption] = 0;
+    m_failed.push_back(assumption);
+  }
+  for (unsigned failed : m_failed) {
+    m_isFailed[failed] = 1;
+  }
+}
+
+// Simplifies the formula before its first search only, later additions are
+// left to inprocessing. A root level conflict makes every later solve
+// unsatisfiable right away
+SolveResult Solver::solve() {
+  if (!m_incremental) initIncremental();
+  m_failed.clear();
+  m_isFailed.clear();
+  m_model.clear();
+
+  SolveResult result = SolveResult::Unsat;
+  if (!m_emptyClause) {
+    backtrack(0);
+    bool ok = propagate() == CRefUndef;
+    if (ok && !m_preprocessed) {
+      m_preprocessed = true;
+      ok = simplify(UINT64_MAX) && probe(m_opts.preprocessTicks);
+      initInprocessing();
+    }
+    // the tracked clauses take part after the caller's own assumptions
+    for (unsigned id = 0; id < m_selectors.size(); id++) {
+      if (m_tracked[id] == Tracked::Active)
+        m_assumptions.push_back(m_selectors[id]);
+    }
+    if (ok) result = CDCL();
+    m_stats.blockedRestarts = m_glucose.blocked();
+    if (result == SolveResult::Unsat && m_failed.empty())
+      m_emptyClause = true;
+  }
+
+  if (result == SolveResult::Sat) extendModel();
+  backtrack(0);
+  m_assumptions.clear();
+  for (Tracked &tracked : m_tracked) {
+    if (tracked == Tracked::Excluded) tracked = Tracked::Active;
+  }
+  return result;
+}
+
+int Solver::val(int lit) const {
+  unsigned ilit = findLit(lit);
+  if (ilit >= m_model.size()) return 0;
+  return m_model[ilit] == ValTrue ? lit : -lit;
+}
+
+bool Solver::failed(int lit) const {
+  unsigned ilit = findLit(lit);
+  return ilit < m_isFailed.size() && m_isFailed[ilit];
+}
+
+std::vector<int> Solver::failedAssumptions() const {
+  std::vector<int> lits;
+  for (unsigned lit : m_failed) {
+    if (exportLit(lit)) lits.push_back(exportLit(lit));
+  }
+  return lits;
+}
+
+std::vector<unsigned> Solver::coreClauses() const {
+  std::vector<unsigned> ids;
+  // selectors are created in ID order, so their literals are sorted
+  for (unsigned lit : m_failed) {
+    auto it = std::lower_bound(m_selectors.begin(), m_selectors.end(), lit);
+    if (it != m_selectors.end() && *it == lit)
+      ids.push_back(it - m_selectors.begin());
+  }
+  return ids;
+}
+
+void Solver::excludeClause(unsigned id) {
+  if (id >= m_tracked.size()) {
+    std::cerr << "Unknown tracked clause: " << id << "\n";
+    throw new std::invalid_argument("Invalid clause ID");
+  }
+  if (m_tracked[id] == Tracked::Active) m_tracked[id] = Tracked::Excluded;
+}
+
+// the clause stays, but its selector becomes false at the root
+void Solver::dropClause(unsigned id) {
+  if (id >= m_tracked.size()) {
+    std::cerr << "Unknown tracked clause: " << id << "\n";
+    throw new std::invalid_argument("Invalid clause ID");
+  }
+  if (m_tracked[id] == Tracked::Dropped) return;
+  m_tracked[id] = Tracked::Dropped;
+  Clause clause = {m_selectors[id] ^ 1};
+  addInternalClause(clause);
+}
+
+} // namespace vasSAT
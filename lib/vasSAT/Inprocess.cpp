@@ -0,0 +1,108 @@
+#include "vasSAT/Solver.hpp"
+#include <algorithm>
+#include <chrono>
+
+namespace vasSAT {
+
+// irredundant and learnt clauses, binary ones included
+uint64_t Solver::countClauses() const {
+  uint64_t count = 0;
+  for (auto *crefs : {&m_clauses, &m_learnts}) {
+    for (CRef cref : *crefs) {
+      if (!m_arena[cref].garbage) count++;
+    }
+  }
+  // each binary clause is stored for both its literals
+  uint64_t binaries = 0;
+  for (auto &implied : m_binaries) {
+    binaries += implied.size();
+  }
+  return count + binaries / 2;
+}
+
+// variables neither eliminated nor assigned at the root level
+unsigned Solver::countActiveVars() const {
+  unsigned count = 0;
+  for (unsigned var = 0; var < m_numVars; var++) {
+    if (m_eliminated[var]) continue;
+    if (value(var * 2) == ValUnassigned || m_level[var] > 0) count++;
+  }
+  return count;
+}
+
+// Every pass starts at its interval, with the ticks spent before the search
+// not counting as search effort
+void Solver::initInprocessing() {
+  m_inprocessTicks = m_ticks;
+  auto init = [&](Pass pass, bool enabled, unsigned interval, double effort) {
+    m_schedule[unsigned(pass)] = {enabled, double(interval), effort, interval,
+                                  0};
+  };
+  init(Pass::Probe, m_opts.probe || m_opts.substitute, m_opts.probeInterval,
+       m_opts.probeEffort);
+  init(Pass::Subsume, m_opts.subsume, m_opts.subsumeInterval,
+       m_opts.subsumeEffort);
+  init(Pass::Vivify, m_opts.vivify, m_opts.vivifyInterval, m_opts.vivifyEffort);
+  init(Pass::Eliminate, m_opts.simp.eliminate, m_opts.eliminateInterval,
+       m_opts.eliminateEffort);
+}
+
+// Runs one pass with a budget of ticks and records its ticks, time and the
+// clauses and variables it removed
+bool Solver::runPass(Pass pass, uint64_t budget) {
+  PassStats &stats = m_stats.passes[unsigned(pass)];
+  auto start = std::chrono::steady_clock::now();
+  uint64_t ticks = m_ticks;
+  int64_t clauses = countClauses();
+  int64_t vars = countActiveVars();
+
+  bool ok = true;
+  switch (pass) {
+  case Pass::Probe:
+    ok = substitute() && probe(budget);
+    break;
+  case Pass::Subsume:
+    ok = subsumeLearnts(budget);
+    break;
+  case Pass::Vivify:
+    ok = vivify(budget);
+    break;
+  case Pass::Eliminate:
+    ok = simplify(budget);
+    break;
+  }
+
+  stats.calls++;
+  stats.ticks += m_ticks - ticks;
+  m_inprocessTicks += m_ticks - ticks;
+  stats.seconds += std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  if (ok) {
+    stats.removedClauses += clauses - int64_t(countClauses());
+    stats.removedVars += vars - int64_t(countActiveVars());
+  }
+  return ok;
+}
+
+// Runs the passes that are due after a conflict. The budget of a pass is its
+// effort times the ticks the search used since its previous run, so the
+// passes take a fixed share of the search whatever their schedule
+bool Solver::inprocess() {
+  uint64_t searchTicks = m_ticks - m_inprocessTicks;
+  for (unsigned p = 0; p < NumPasses; p++) {
+    Schedule &schedule = m_schedule[p];
+    if (!schedule.enabled || m_stats.conflicts < schedule.next) continue;
+
+    uint64_t budget = std::max<uint64_t>(
+        m_opts.inprocessMinTicks,
+        schedule.effort * (searchTicks - schedule.searchTicks));
+    if (!runPass(Pass(p), budget)) return false;
+    schedule.searchTicks = searchTicks;
+    schedule.interval *= m_opts.inprocessGrowth;
+    schedule.next = m_stats.conflicts + schedule.interval;
+  }
+  return true;
+}
+
+} // namespace vasSAT
@@ -0,0 +1,130 @@
+#include "vasSAT/ipasir.h"
+#include "vasSAT/Solver.hpp"
+#include <climits>
+#include <iostream>
+
+namespace {
+
+// the solver and the clause being added to it
+struct IpasirSolver {
+  vasSAT::Solver solver;
+  std::vector<int> clause;
+};
+
+IpasirSolver &get(void *solver) {
+  return *static_cast<IpasirSolver *>(solver);
+}
+
+// 0 ends clauses and INT_MIN has no negation
+bool validLit(int lit) { return lit != 0 && lit != INT_MIN; }
+
+// Exceptions must not reach the C caller, so each entry point that can throw
+// reports it here and returns its failure value instead
+void report(const char *function) {
+  std::cerr << function << ": solver error\n";
+}
+
+} // namespace
+
+extern "C" {
+
+const char *ipasir_signature() { return "vasSAT 0.0.1"; }
+
+void *ipasir_init() {
+  try {
+    return new IpasirSolver();
+  } catch (...) {
+    report("ipasir_init");
+    return nullptr;
+  }
+}
+
+void ipasir_release(void *solver) {
+  delete static_cast<IpasirSolver *>(solver);
+}
+
+void ipasir_add(void *solver, int lit_or_zero) {
+  IpasirSolver &s = get(solver);
+  if (lit_or_zero == INT_MIN) {
+    std::cerr << "ipasir_add: invalid literal\n";
+    return;
+  }
+  try {
+    if (lit_or_zero) {
+      s.clause.push_back(lit_or_zero);
+      return;
+    }
+    s.solver.addClause(s.clause);
+  } catch (...) {
+    report("ipasir_add");
+  }
+  s.clause.clear();
+}
+
+void ipasir_assume(void *solver, int lit) {
+  if (!validLit(lit)) {
+    std::cerr << "ipasir_assume: invalid literal\n";
+    return;
+  }
+  try {
+    get(solver).solver.assume(lit);
+  } catch (...) {
+    report("ipasir_assume");
+  }
+}
+
+int ipasir_solve(void *solver) {
+  try {
+    switch (get(solver).solver.solve()) {
+    case vasSAT::SolveResult::Sat:
+      return 10;
+    case vasSAT::SolveResult::Unsat:
+      return 20;
+    case vasSAT::SolveResult::Unknown:
+      break;
+    }
+  } catch (...) {
+    report("ipasir_solve");
+  }
+  return 0;
+}
+
+int ipasir_val(void *solver, int lit) {
+  return validLit(lit) ? get(solver).solver.val(lit) : 0;
+}
+
+int ipasir_failed(void *solver, int lit) {
+  return validLit(lit) && get(solver).solver.failed(lit);
+}
+
+void ipasir_set_terminate(void *solver, void *data,
+                          int (*terminate)(void *data)) {
+  try {
+    if (!terminate) {
+      get(solver).solver.setTerminate(nullptr);
+      return;
+    }
+    get(solver).solver.setTerminate([=] { return terminate(data) != 0; });
+  } catch (...) {
+    report("ipasir_set_terminate");
+  }
+}
+
+void ipasir_set_learn(void *solver, void *data, int max_length,
+                      void (*learn)(void *data, int *clause)) {
+  try {
+    if (!learn || max_length < 0) {
+      get(solver).solver.setLearn(0, nullptr);
+      return;
+    }
+    get(solver).solver.setLearn(max_length,
+                                [=](const std::vector<int> &lits) {
+                                  std::vector<int> clause = lits;
+                                  clause.push_back(0);
+                                  learn(data, clause.data());
+                                });
+  } catch (...) {
+    report("ipasir_set_learn");
+  }
+}
+}
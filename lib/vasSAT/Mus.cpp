@@ -0,0 +1,115 @@
+#include "vasSAT/Solver.hpp"
+
+namespace vasSAT {
+
+// Deletion based extraction on the incremental interface, where clause i of F
+// is the tracked clause with ID i. Leaving candidate c out of the working set
+// either keeps it unsatisfiable, when the set shrinks to the core of that
+// solve, or gives a model falsifying only c, which makes c necessary. Model
+// rotation then flips each variable of c in turn: if that falsifies exactly
+// one other clause of the set, the flipped model shows it necessary as well,
+// without a solve
+std::vector<unsigned>
+Solver::extractMUS(const std::unique_ptr<CNFFormula> &F) {
+  initIncremental();
+  const std::vector<Clause> &clauses = F->m_clauses;
+  int numVars = F->m_asgnMap.size();
+
+  std::vector<std::vector<unsigned>> occurs(numVars * 2);
+  for (unsigned idx = 0; idx < clauses.size(); idx++) {
+    std::vector<int> lits;
+    for (unsigned lit : clauses[idx]) {
+      lits.push_back(lit % 2 ? -int(lit / 2 + 1) : int(lit / 2 + 1));
+      occurs[lit].push_back(idx);
+    }
+    addTrackedClause(lits);
+  }
+
+  enum : char { Removed, Candidate, Necessary };
+  std::vector<char> state(clauses.size(), Candidate);
+  // removes the clauses of the set outside the core of the last solve
+  auto refine = [&]() {
+    std::vector<char> core(clauses.size(), 0);
+    for (unsigned idx : coreClauses()) {
+      core[idx] = 1;
+    }
+    for (unsigned idx = 0; idx < clauses.size(); idx++) {
+      if (state[idx] != Candidate || core[idx]) continue;
+      state[idx] = Removed;
+      dropClause(idx);
+    }
+  };
+
+  SolveResult result = solve();
+  m_stats.musSolves++;
+  if (result != SolveResult::Unsat) return {};
+  refine();
+
+  // true or false by literal, with the model each clause left to rotate
+  // falsifies as the only one of the set
+  using Model = std::vector<char>;
+  std::vector<std::pair<unsigned, Model>> stack;
+  auto rotate = [&]() {
+    while (!stack.empty()) {
+      unsigned idx = stack.back().first;
+      Model model = std::move(stack.back().second);
+      stack.pop_back();
+      auto falsified = [&](unsigned other) {
+        for (unsigned lit : clauses[other]) {
+          if (model[lit]) return false;
+        }
+        return true;
+      };
+      for (unsigned lit : clauses[idx]) {
+        model[lit] = 1;
+        model[lit ^ 1] = 0;
+        // lit is true now, so only clauses with its negation can be falsified
+        unsigned found = ~0u, count = 0;
+        for (unsigned other : occurs[lit ^ 1]) {
+          if (state[other] == Removed || other == found || !falsified(other))
+            continue;
+          found = other;
+          if (++count > 1) break;
+        }
+        if (count == 1 && state[found] == Candidate) {
+          m_stats.musRotations++;
+          state[found] = Necessary;
+          stack.push_back({found, model});
+        }
+        model[lit] = 0;
+        model[lit ^ 1] = 1;
+      }
+    }
+  };
+
+  for (unsigned idx = 0; idx < clauses.size(); idx++) {
+    if (state[idx] != Candidate) continue;
+    excludeClause(idx);
+    result = solve();
+    m_stats.musSolves++;
+
+    if (result == SolveResult::Unsat) {
+      state[idx] = Removed;
+      dropClause(idx);
+      refine();
+      continue;
+    }
+    if (result != SolveResult::Sat) return {};
+    state[idx] = Necessary;
+    Model model(numVars * 2);
+    for (int var = 1; var <= numVars; var++) {
+      model[(var - 1) * 2] = val(var) > 0;
+      model[(var - 1) * 2 + 1] = val(var) < 0;
+    }
+    stack.push_back({idx, std::move(model)});
+    rotate();
+  }
+
+  std::vector<unsigned> mus;
+  for (unsigned idx = 0; idx < clauses.size(); idx++) {
+    if (state[idx] == Necessary) mus.push_back(idx);
+  }
+  return mus;
+}
+
+} // namespace vasSAT
@@ -0,0 +1,146 @@
+#include "vasSAT/Solver.hpp"
+#include <algorithm>
+
+namespace vasSAT {
+
+// assigns lit on a new decision level and propagates it
+bool Solver::probeLiteral(unsigned lit) {
+  m_trailLim.push_back(m_trail.size());
+  enqueue(lit, CRefUndef);
+  return propagate() == CRefUndef;
+}
+
+// Hyper-binary resolution on the trail of the probed literal, the only
+// decision. The literals it implies form a tree below it, where a literal
+// implied by a binary clause hangs off the other literal of that clause. A
+// literal implied by a longer clause is implied by the dominator of that
+// clause's other literals, which is their lowest common ancestor in the tree,
+// so the binary clause of the dominator's negation and the literal is the
+// resolvent. The literal then hangs off the dominator, and the resolvent is
+// only added when no binary clause already links the two
+void Solver::hyperBinaryResolve() {
+  unsigned start = m_trailLim[0];
+  // parent and depth in the tree, by trail position
+  std::vector<unsigned> parent(m_trail.size() - start, 0);
+  std::vector<unsigned> depth(m_trail.size() - start, 0);
+  auto position = [&](unsigned implied) {
+    return m_trailPos[implied / 2] - start;
+  };
+  auto dominator = [&](unsigned a, unsigned b) {
+    while (a != b) {
+      if (depth[a] < depth[b]) std::swap(a, b);
+      a = parent[a];
+    }
+    return a;
+  };
+
+  for (unsigned i = start + 1; i < m_trail.size(); i++) {
+    unsigned implied = m_trail[i];
+    CRef reason = m_reason[implied / 2];
+    unsigned node = i - start;
+    if (reason == CRefUndef) continue;
+    if (isBinary(reason)) {
+      parent[node] = position(reason ^ CRefBinary);
+      depth[node] = depth[parent[node]] + 1;
+      continue;
+    }
+
+    ArenaClause &clause = m_arena[reason];
+    m_ticks += clause.size;
+    unsigned dom = NoLiteral;
+    for (unsigned k = 1; k < clause.size; k++) {
+      if (m_level[clause[k] / 2] == 0) continue;
+      unsigned other = position(clause[k]);
+      dom = dom == NoLiteral ? other : dominator(dom, other);
+    }
+    if (dom == NoLiteral) dom = 0;
+    parent[node] = dom;
+    depth[node] = depth[dom] + 1;
+
+    unsigned negation = m_trail[start + dom] ^ 1;
+    auto &binaries = m_binaries[negation];
+    m_ticks += binaries.size();
+    if (std::find(binaries.begin(), binaries.end(), implied) != binaries.end())
+      continue;
+    binaries.push_back(implied);
+    m_binaries[implied].push_back(negation);
+    m_stats.hyperBinaries++;
+  }
+}
+
+// Probes both polarities of every root of the binary implication graph, that
+// is every literal implying others through binary clauses without being
+// implied by one itself. A polarity leading to a conflict is a failed literal
+// and its negation is learnt as unit, as are the literals both polarities
+// imply. Stops once the round used up its budget of propagation ticks
+bool Solver::probe(uint64_t budget) {
+  if (!m_opts.probe) return true;
+
+  backtrack(0);
+  if (propagate() != CRefUndef) return false;
+
+  std::vector<unsigned> roots;
+  for (unsigned lit = 0; lit < m_numVars * 2; lit++) {
+    if (m_eliminated[lit / 2] || value(lit) != ValUnassigned) continue;
+    if (m_binaries[lit].empty() && !m_binaries[lit ^ 1].empty())
+      roots.push_back(lit);
+  }
+
+  std::vector<char> implied(m_numVars * 2, 0);
+  std::vector<unsigned> units;
+  uint64_t limit = m_ticks + budget;
+
+  auto failed = [&](unsigned lit) {
+    backtrack(0, false);
+    m_stats.failedLiterals++;
+    enqueue(lit ^ 1, CRefUndef);
+    return propagate() == CRefUndef;
+  };
+
+  unsigned i = 0;
+  for (; i < roots.size() && m_ticks < limit; i++) {
+    unsigned root = roots[(m_probeNext + i) % roots.size()];
+    if (value(root) != ValUnassigned) continue;
+
+    if (!probeLiteral(root)) {
+      if (!failed(root)) return false;
+      continue;
+    }
+    unsigned start = m_trailLim[0] + 1;
+    std::vector<unsigned> first(m_trail.begin() + start, m_trail.end());
+    for (unsigned lit : first) {
+      implied[lit] = 1;
+    }
+    if (m_opts.hyperBinary) hyperBinaryResolve();
+    backtrack(0, false);
+
+    bool ok = probeLiteral(root ^ 1);
+    if (ok) {
+      for (unsigned k = start; k < m_trail.size(); k++) {
+        if (implied[m_trail[k]]) units.push_back(m_trail[k]);
+      }
+      if (m_opts.hyperBinary) hyperBinaryResolve();
+    }
+    for (unsigned lit : first) {
+      implied[lit] = 0;
+    }
+    if (!ok) {
+      if (!failed(root ^ 1)) return false;
+      continue;
+    }
+    backtrack(0, false);
+
+    for (unsigned lit : units) {
+      if (value(lit) != ValUnassigned) continue;
+      m_stats.probeUnits++;
+      enqueue(lit, CRefUndef);
+    }
+    units.clear();
+    if (propagate() != CRefUndef) return false;
+  }
+
+  m_probeNext += i;
+  return true;
+}
+
+} // namespace vasSAT
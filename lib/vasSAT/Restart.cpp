@@ -0,0 +1,62 @@
+#include "vasSAT/Restart.hpp"
+
+namespace vasSAT {
+
+uint64_t LubyRestart::luby(uint64_t i) {
+  // find the finite subsequence that contains index i and its size
+  uint64_t size = 1;
+  unsigned seq = 0;
+  while (size < i + 1) {
+    seq++;
+    size = 2 * size + 1;
+  }
+
+  while (size - 1 != i) {
+    size = (size - 1) >> 1;
+    seq--;
+    i = i % size;
+  }
+  return uint64_t(1) << seq;
+}
+
+void LubyRestart::init() {
+  m_restarts = 0;
+  m_conflicts = 0;
+  m_limit = m_unit;
+}
+
+void LubyRestart::restarted() {
+  m_restarts++;
+  m_conflicts = 0;
+  m_limit = m_unit * luby(m_restarts);
+}
+
+void GlucoseRestart::init() {
+  m_fastLBD.reset();
+  m_slowLBD.reset();
+  m_trailSize.reset();
+  m_conflicts = 0;
+  m_totalConflicts = 0;
+  m_blocked = 0;
+}
+
+void GlucoseRestart::conflict(unsigned lbd, unsigned trailSize) {
+  m_conflicts++;
+  m_totalConflicts++;
+  m_fastLBD.update(lbd);
+  m_slowLBD.update(lbd);
+
+  if (m_totalConflicts > blockAfter && m_conflicts >= minConflicts &&
+      trailSize > blockMargin * m_trailSize.value) {
+    m_conflicts = 0;
+    m_blocked++;
+  }
+  m_trailSize.update(trailSize);
+}
+
+bool GlucoseRestart::shouldRestart() {
+  if (m_conflicts < minConflicts) return false;
+  return m_fastLBD.value > margin * m_slowLBD.value;
+}
+
+} // namespace vasSAT
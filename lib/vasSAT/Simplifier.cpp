@@ -0,0 +1,104 @@
+#include "vasSAT/Simplifier.hpp"
+#include <algorithm>
+
+namespace vasSAT {
+
+Simplifier::Simplifier(const SimplifierOptions &opts,
+                       const std::vector<int8_t> &vals,
+                       std::vector<char> &eliminated,
+                       ExtensionStack &extension)
+    : m_opts(opts), m_occurs(vals.size()), m_vals(vals),
+      m_eliminated(eliminated), m_extension(extension), m_marks(vals.size()) {
+}
+
+void Simplifier::addClause(const Clause &clause) {
+  Clause lits = clause;
+  std::sort(lits.begin(), lits.end());
+  lits.erase(std::unique(lits.begin(), lits.end()), lits.end());
+
+  unsigned j = 0;
+  for (unsigned k = 0; k < lits.size(); k++) {
+    // both literals of a variable are next to each other once sorted
+    if (k + 1 < lits.size() && (lits[k] ^ 1) == lits[k + 1]) return;
+    if (m_vals[lits[k]] > 0) return;
+    if (m_vals[lits[k]] == 0) lits[j++] = lits[k];
+  }
+  lits.resize(j);
+
+  if (lits.empty()) {
+    m_unsat = true;
+    return;
+  }
+  if (lits.size() == 1) {
+    assign(lits[0]);
+    return;
+  }
+
+  unsigned idx = m_clauses.size();
+  for (unsigned lit : lits) {
+    m_occurs[lit].push_back(idx);
+  }
+  m_clauses.push_back(std::move(lits));
+  m_removed.push_back(0);
+}
+
+void Simplifier::assign(unsigned lit) {
+  m_vals[lit] = 1;
+  m_vals[lit ^ 1] = -1;
+  m_units.push_back(lit);
+  m_stats.units++;
+}
+
+// Removes the clauses satisfied by the new units and their negations from the
+// remaining clauses. Afterwards no clause contains an assigned literal
+bool Simplifier::propagate() {
+  while (!m_unsat && m_propagated < m_units.size()) {
+    unsigned lit = m_units[m_propagated++];
+
+    for (unsigned idx : m_occurs[lit]) {
+      if (!m_removed[idx]) removeClause(idx);
+    }
+    for (unsigned idx : m_occurs[lit ^ 1]) {
+      if (m_removed[idx]) continue;
+      Clause &clause = m_clauses[idx];
+      clause.erase(std::find(clause.begin(), clause.end(), lit ^ 1));
+      if (clause.size() > 1) continue;
+
+      unsigned unit = clause[0];
+      removeClause(idx);
+      if (m_vals[unit] < 0) m_unsat = true;
+      else if (m_vals[unit] == 0) assign(unit);
+    }
+
+    m_occurs[lit].clear();
+    m_occurs[lit ^ 1].clear();
+  }
+  return !m_unsat;
+}
+
+void Simplifier::removeClause(unsigned idx) {
+  m_removed[idx] = 1;
+  m_stats.removedClauses++;
+  Clause().swap(m_clauses[idx]);
+}
+
+std::vector<unsigned> &Simplifier::occurrences(unsigned lit) {
+  auto &occurs = m_occurs[lit];
+  occurs.erase(std::remove_if(occurs.begin(), occurs.end(),
+                              [&](unsigned idx) { return m_removed[idx]; }),
+               occurs.end());
+  return occurs;
+}
+
+void Simplifier::collect(std::vector<Clause> &out) {
+  for (unsigned idx = 0; idx < m_clauses.size(); idx++) {
+    if (!m_removed[idx]) out.push_back(std::move(m_clauses[idx]));
+  }
+  m_clauses.clear();
+  m_removed.clear();
+  for (auto &occurs : m_occurs) {
+    occurs.clear();
+  }
+}
+
+} // namespace vasSAT
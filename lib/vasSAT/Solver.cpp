@@ -1,129 +1,1097 @@
 #include "vasSAT/Solver.hpp"
-#include <stack>
+#include <algorithm>
+#include <ostream>
 
 namespace vasSAT {
-struct Solver::DecisionData {
-  unsigned var;
-  std::stack<unsigned> props;
-};
-
-void Solver::initVtcMap(VarToClauseMap &vtcMap,
-                        const std::unique_ptr<CNFFormula> &F) const {
-  for (auto &clause : F->m_clauses) {
-    for (unsigned lit : clause) {
-      if (vtcMap.find(lit / 2) == vtcMap.end()) {
-        vtcMap.insert({lit / 2, std::vector<Clause *>()});
-      }
-      vtcMap.find(lit / 2)->second.push_back(&clause);
+
+void Solver::initWatches(const std::vector<Clause> &clauses) {
+  m_watches.assign(m_numVars * 2, WatchList());
+  m_binaries.assign(m_numVars * 2, std::vector<unsigned>());
+  m_isDirty.assign(m_numVars * 2, 0);
+  m_dirtyWatches.clear();
+  m_arena.clear();
+  m_clauses.clear();
+  m_learnts.clear();
+  m_units.clear();
+  m_emptyClause = false;
+
+  // repeated literals are dropped, so (l l) becomes the unit l, and so are
+  // tautologies. The order of the rest is kept for the watches
+  std::vector<char> marks(m_numVars * 2, 0);
+  for (const Clause &original : clauses) {
+    Clause clause;
+    bool tautology = false;
+    for (unsigned lit : original) {
+      tautology |= marks[lit ^ 1];
+      if (!marks[lit]) clause.push_back(lit);
+      marks[lit] = 1;
+    }
+    for (unsigned lit : original) {
+      marks[lit] = 0;
+    }
+    if (tautology) continue;
+    if (clause.empty()) {
+      m_emptyClause = true;
+      continue;
+    }
+    if (clause.size() == 1) {
+      m_units.push_back(clause[0]);
+      continue;
+    }
+    if (clause.size() == 2) {
+      m_binaries[clause[0]].push_back(clause[1]);
+      m_binaries[clause[1]].push_back(clause[0]);
+      continue;
     }
+    CRef cref = m_arena.alloc(clause, false);
+    m_clauses.push_back(cref);
+    m_watches[clause[0]].push_back({cref, clause[1]});
+    m_watches[clause[1]].push_back({cref, clause[0]});
   }
 }
 
-bool Solver::Solve(std::unique_ptr<CNFFormula> &F) const {
+bool Solver::Solve(std::unique_ptr<CNFFormula> &F) {
+  m_stats = SolverStats();
+  m_incremental = false;
+  m_assumptions.clear();
+  m_failed.clear();
+  m_isFailed.clear();
+  m_numVars = F->m_asgnMap.size();
+  m_vals.assign(m_numVars * 2, ValUnassigned);
+  m_eliminated.assign(m_numVars, 0);
+  m_extension.clear();
+  // the formula numbers its variables in order of first appearance
+  m_internalVars.clear();
+  m_externalVars.assign(m_numVars, 0);
+  for (auto [external, internal] : F->m_vars) {
+    m_externalVars[internal] = external;
+  }
+  // variables added by factoring come after the ones of the formula
+  std::vector<Clause> factored;
+  if (factor(F->m_clauses, factored)) initWatches(factored);
+  else initWatches(F->m_clauses);
 
-  VarToClauseMap vtcMap;
-  CNFFormula::AssignmentMap asgnMap;
+  bool sat = false;
+  if (!m_emptyClause && initSearch() && substitute() &&
+      simplify(UINT64_MAX) && probe(m_opts.preprocessTicks)) {
+    if (m_opts.mode == SearchMode::CDCL) {
+      initInprocessing();
+      sat = CDCL() == SolveResult::Sat;
+      m_stats.blockedRestarts = m_glucose.blocked();
+    } else {
+      sat = DPLL();
+    }
+  }
 
-  initVtcMap(vtcMap, F);
+  if (sat) extendModel();
 
-  return DPLL(vtcMap, F);
+  // the formula keeps its per-variable assignment for printing the model
+  for (unsigned var = 0; var < F->m_asgnMap.size(); var++) {
+    int8_t val = sat ? m_model[var * 2] : value(var * 2);
+    F->m_asgnMap[var] = val == ValTrue    ? CNFFormula::Assignment::True
+                        : val == ValFalse ? CNFFormula::Assignment::False
+                                          : CNFFormula::Assignment::Empty;
+  }
+  return sat;
 }
 
-bool Solver::DPLL(VarToClauseMap &vtcMap,
-                  std::unique_ptr<CNFFormula> &F) const {
-  bool conflict = false;
+void Solver::printStats(std::ostream &os) const {
+  os << "decisions:     " << m_stats.decisions << "\n";
+  os << "propagations:  " << m_stats.propagations << "\n";
+  os << "conflicts:     " << m_stats.conflicts << "\n";
+  os << "mode switches: " << m_stats.modeSwitches << "\n";
+  os << "rephases:      " << m_stats.rephases << "\n";
+  os << "restarts:      " << m_stats.restarts << "\n";
+  os << "reused trails: " << m_stats.reusedTrails << "\n";
+  os << "blocked:       " << m_stats.blockedRestarts << "\n";
+  os << "reductions:    " << m_stats.reductions << "\n";
+  os << "learnt:        " << m_stats.learntClauses << "\n";
+  os << "minimized:     " << m_stats.minimizedLiterals << "\n";
+  os << "shrunk:        " << m_stats.shrunkLiterals << "\n";
+  os << "deleted:       " << m_stats.deletedClauses << "\n";
+  os << "collections:   " << m_stats.garbageCollections << "\n";
+  os << "subsumed:      " << m_stats.subsumedClauses << "\n";
+  os << "strengthened:  " << m_stats.strengthenedClauses << "\n";
+  os << "eliminated:    " << m_stats.eliminatedVars << "\n";
+  os << "gates:         " << m_stats.gateEliminations << "\n";
+  os << "added vars:    " << m_stats.addedVars << "\n";
+  os << "factored:      " << m_stats.factoredClauses << "\n";
+  os << "hidden taut:   " << m_stats.hiddenTautologies << "\n";
+  os << "hidden lits:   " << m_stats.hiddenLiterals << "\n";
+  os << "blocked cls:   " << m_stats.blockedClauses << "\n";
+  os << "covered cls:   " << m_stats.coveredClauses << "\n";
+  os << "failed lits:   " << m_stats.failedLiterals << "\n";
+  os << "probe units:   " << m_stats.probeUnits << "\n";
+  os << "hyper binary:  " << m_stats.hyperBinaries << "\n";
+  os << "substituted:   " << m_stats.substitutedVars << "\n";
+  os << "vivified:      " << m_stats.vivifiedClauses << "\n";
+  os << "vivified lits: " << m_stats.vivifiedLiterals << "\n";
+  os << "mus solves:    " << m_stats.musSolves << "\n";
+  os << "mus rotations: " << m_stats.musRotations << "\n";
+  const char *passes[NumPasses] = {"probe pass:    ", "subsume pass:  ",
+                                   "vivify pass:   ", "elim pass:     "};
+  for (unsigned p = 0; p < NumPasses; p++) {
+    const PassStats &pass = m_stats.passes[p];
+    os << passes[p] << pass.calls << " runs, " << pass.ticks << " ticks, "
+       << pass.seconds << "s, " << pass.removedClauses << " clauses, "
+       << pass.removedVars << " vars removed\n";
+  }
+  os.flush();
+}
 
-  // each decision has a list of consequenting clause propagations and a node
-  // in the decision tree
-  std::stack<DecisionData> decisions;
+// Chronological backtracking on the same trail and propagation as CDCL: on a
+// conflict the most recent decision that was not flipped yet is flipped. A
+// flipped decision is enqueued one level below its own, so it is undone
+// together with the decision it depends on
+bool Solver::DPLL() {
+  m_queue = &m_staticQueue;
+  while (true) {
+    if (propagate() != CRefUndef) {
+      m_stats.conflicts++;
+      if (decisionLevel() == 0) return false;
 
-  auto unitProp = [&](DecisionData &dd) {
-    std::stack<unsigned> toProp;
-    toProp.push(dd.var);
+      unsigned decision = m_trail[m_trailLim.back()];
+      backtrack(decisionLevel() - 1);
+      enqueue(decision ^ 1, CRefUndef);
+      continue;
+    }
 
-    while (!toProp.empty()) {
-      unsigned var = toProp.top();
-      toProp.pop();
+    unsigned var;
+    if (!pickBranchVar(var)) return true;
 
-      // go to every clause the variable is in
-      for (auto &clause : vtcMap.find(var)->second) {
-        bool satisfied = false;
-        unsigned numEmpty = 0;
-        unsigned emptyIdx = 0;
+    m_stats.decisions++;
+    m_trailLim.push_back(m_trail.size());
+    enqueue(var * 2 + 1, CRefUndef);
+  }
+}
+
+void Solver::enqueue(unsigned lit, CRef reason) {
+  unsigned var = lit / 2;
+  assign(lit);
+  m_level[var] = decisionLevel();
+  m_reason[var] = reason;
+  m_trailPos[var] = m_trail.size();
+  m_trail.push_back(lit);
+}
 
-        for (int i = 0; i < clause->size(); i++) {
-          unsigned lit = (*clause)[i];
-          bool negation = lit % 2;
-          auto asgn = F->m_asgnMap[lit / 2];
+CRef Solver::propagate() {
+  while (m_qhead < m_trail.size()) {
+    unsigned falseLit = m_trail[m_qhead++] ^ 1;
 
-          if (asgn == CNFFormula::Assignment::Empty) {
-            numEmpty++;
-            emptyIdx = i;
+    // binary clauses first, they never touch the arena
+    for (unsigned other : m_binaries[falseLit]) {
+      int8_t val = value(other);
+      if (val == ValTrue) continue;
+      if (val == ValFalse) {
+        m_binaryConflict = falseLit;
+        m_qhead = m_trail.size();
+        return CRefBinary | other;
+      }
+      m_stats.propagations++;
+      enqueue(other, CRefBinary | falseLit);
+    }
+
+    auto &watches = m_watches[falseLit];
+    m_ticks += 1 + watches.size();
+    unsigned i = 0, j = 0;
+    while (i < watches.size()) {
+      Watch w = watches[i++];
+      if (value(w.blocker) == ValTrue) {
+        watches[j++] = w;
+        continue;
+      }
 
-            // if there is more than one unassigned variable in the clause we
-            // can't infer anything
-            if (numEmpty > 1) { break; }
-          }
-          // we can skip the clause if there is a single "true"
-          else if ((negation && asgn == CNFFormula::Assignment::False) ||
-                   (!negation && asgn == CNFFormula::Assignment::True)) {
-            satisfied = true;
-            break;
-          }
+      // reasons keep their implied literal in the first position, so the
+      // falsified literal always moves to the second one
+      ArenaClause &clause = m_arena[w.cref];
+      if (clause[0] == falseLit) std::swap(clause[0], clause[1]);
+
+      unsigned first = clause[0];
+      w.blocker = first;
+      if (value(first) == ValTrue) {
+        watches[j++] = w;
+        continue;
+      }
+
+      bool moved = false;
+      for (unsigned k = 2; k < clause.size; k++) {
+        if (value(clause[k]) != ValFalse) {
+          clause[1] = clause[k];
+          clause[k] = falseLit;
+          m_watches[clause[1]].push_back(w);
+          moved = true;
+          break;
         }
-        if (satisfied || numEmpty > 1) continue;
-        if (numEmpty == 0) {
-          conflict = true;
-          return;
+      }
+      if (moved) continue;
+
+      watches[j++] = w;
+      if (value(first) == ValFalse) {
+        while (i < watches.size()) {
+          watches[j++] = watches[i++];
         }
-        unsigned var = (*clause)[emptyIdx] / 2;
-        if ((*clause)[emptyIdx] % 2) {
-          F->m_asgnMap[var] = CNFFormula::Assignment::False;
-        } else {
-          F->m_asgnMap[var] = CNFFormula::Assignment::True;
+        watches.resize(j);
+        m_qhead = m_trail.size();
+        return w.cref;
+      }
+      m_stats.propagations++;
+      enqueue(first, w.cref);
+    }
+    watches.resize(j);
+  }
+  return CRefUndef;
+}
+
+// First-UIP conflict analysis: resolve the conflict clause with the reasons of
+// the current level's literals, walking the trail backwards, until a single
+// literal of the current level remains. Its negation becomes learnt[0] and
+// the highest remaining level is the level we can backjump to
+void Solver::analyze(CRef conflict, std::vector<unsigned> &learnt,
+                     unsigned &btLevel) {
+  unsigned pathCount = 0;
+  unsigned lit = 0;
+  bool first = true;
+  int idx = m_trail.size() - 1;
+
+  learnt.clear();
+  learnt.push_back(0);
+  m_bumped.clear();
+
+  unsigned binary[2];
+  do {
+    const unsigned *lits;
+    unsigned size;
+    if (isBinary(conflict)) {
+      binary[0] = first ? m_binaryConflict : lit;
+      binary[1] = conflict ^ CRefBinary;
+      lits = binary;
+      size = 2;
+    } else {
+      ArenaClause &clause = m_arena[conflict];
+      if (clause.learnt) bumpClause(clause);
+      lits = clause.begin();
+      size = clause.size;
+    }
+
+    for (unsigned k = first ? 0 : 1; k < size; k++) {
+      unsigned var = lits[k] / 2;
+      if (m_seen[var] || m_level[var] == 0) continue;
+
+      m_seen[var] = 1;
+      m_bumped.push_back(var);
+      if (m_level[var] >= decisionLevel()) pathCount++;
+      else learnt.push_back(lits[k]);
+    }
+
+    while (!m_seen[m_trail[idx] / 2]) {
+      idx--;
+    }
+    lit = m_trail[idx--];
+    conflict = m_reason[lit / 2];
+    m_seen[lit / 2] = 0;
+    pathCount--;
+    first = false;
+  } while (pathCount > 0);
+  learnt[0] = lit ^ 1;
+
+  m_analyzeClear.clear();
+  if (m_opts.shrink) shrink(learnt);
+  if (m_opts.minimize) minimize(learnt);
+
+  // the literal with the highest level goes to the second position so it is
+  // watched alongside the asserting literal
+  btLevel = 0;
+  for (unsigned k = 1; k < learnt.size(); k++) {
+    unsigned level = m_level[learnt[k] / 2];
+    if (level > btLevel) {
+      btLevel = level;
+      std::swap(learnt[1], learnt[k]);
+    }
+  }
+
+  for (unsigned k = 1; k < learnt.size(); k++) {
+    m_seen[learnt[k] / 2] = 0;
+  }
+  for (unsigned var : m_analyzeClear) {
+    m_seen[var] = 0;
+  }
+}
+
+// Drops the literals of the learnt clause that are implied by the others: a
+// literal is redundant if every path through the reasons leading to it ends in
+// literals of the clause. Only variables of the clause are marked in m_seen
+void Solver::minimize(std::vector<unsigned> &learnt) {
+  uint32_t levels = 0;
+  for (unsigned k = 1; k < learnt.size(); k++) {
+    levels |= abstractLevel(learnt[k] / 2);
+  }
+
+  // dropped literals stay marked, they are implied by the clause as well
+  unsigned j = 1;
+  for (unsigned k = 1; k < learnt.size(); k++) {
+    if (m_reason[learnt[k] / 2] != CRefUndef && redundant(learnt[k], levels))
+      m_analyzeClear.push_back(learnt[k] / 2);
+    else
+      learnt[j++] = learnt[k];
+  }
+  m_stats.minimizedLiterals += learnt.size() - j;
+  learnt.resize(j);
+}
+
+// Depth-first search through the reasons of lit. A literal from a decision
+// level without any literal of the clause can never be resolved away, which
+// the abstract level bitmask rules out without following its reasons
+bool Solver::redundant(unsigned lit, uint32_t levels) {
+  unsigned top = m_analyzeClear.size();
+  m_analyzeStack.clear();
+  m_analyzeStack.push_back(lit);
+
+  while (!m_analyzeStack.empty()) {
+    CRef reason = m_reason[m_analyzeStack.back() / 2];
+    m_analyzeStack.pop_back();
+
+    const unsigned *lits;
+    unsigned size;
+    unsigned binary;
+    if (isBinary(reason)) {
+      binary = reason ^ CRefBinary;
+      lits = &binary;
+      size = 1;
+    } else {
+      // the implied literal is the first one of its reason
+      lits = m_arena[reason].begin() + 1;
+      size = m_arena[reason].size - 1;
+    }
+
+    for (unsigned k = 0; k < size; k++) {
+      unsigned var = lits[k] / 2;
+      if (m_seen[var] || m_level[var] == 0) continue;
+
+      if (m_reason[var] == CRefUndef || !(abstractLevel(var) & levels)) {
+        for (unsigned i = top; i < m_analyzeClear.size(); i++) {
+          m_seen[m_analyzeClear[i]] = 0;
         }
-        dd.props.push(var);
-        toProp.push(var);
+        m_analyzeClear.resize(top);
+        return false;
       }
+      m_seen[var] = 1;
+      m_analyzeStack.push_back(lits[k]);
+      m_analyzeClear.push_back(var);
     }
-  };
+  }
+  return true;
+}
 
-  for (unsigned i = 0; i < F->m_asgnMap.size();) {
+// For every decision level with several literals in the learnt clause, looks
+// for a single literal of that level which implies all of them through binary
+// clauses and replaces them with it. Expects exactly the variables of the
+// clause to be marked in m_seen
+void Solver::shrink(std::vector<unsigned> &learnt) {
+  std::sort(learnt.begin() + 1, learnt.end(), [&](unsigned a, unsigned b) {
+    if (m_level[a / 2] != m_level[b / 2])
+      return m_level[a / 2] > m_level[b / 2];
+    return m_trailPos[a / 2] > m_trailPos[b / 2];
+  });
 
-    if (!conflict) {
-      auto &asgn = F->m_asgnMap[i];
+  unsigned j = 1;
+  unsigned k = 1;
+  while (k < learnt.size()) {
+    unsigned level = m_level[learnt[k] / 2];
+    unsigned end = k + 1;
+    while (end < learnt.size() && m_level[learnt[end] / 2] == level) {
+      end++;
+    }
 
-      if (asgn == CNFFormula::Assignment::Empty) {
-        F->m_asgnMap[i] = CNFFormula::Assignment::False;
-        decisions.push({i, std::stack<unsigned>()});
-        unitProp(decisions.top());
+    unsigned uip = ~0u;
+    if (end - k > 1)
+      uip = shrinkLevel(level, end - k, m_trailPos[learnt[k] / 2]);
+    if (uip == ~0u) {
+      while (k < end) {
+        learnt[j++] = learnt[k++];
       }
-      ++i;
-    } else {
+      continue;
+    }
+
+    m_stats.shrunkLiterals += end - k - 1;
+    for (; k < end; k++) {
+      m_seen[learnt[k] / 2] = 0;
+    }
+    m_seen[uip / 2] = 1;
+    learnt[j++] = uip ^ 1;
+  }
+  learnt.resize(j);
+}
+
+// Walks the trail of the level backwards from pos, resolving the open
+// literals with their binary reasons until only one is left, which is
+// returned. Gives up on a longer reason or a literal of another level that is
+// not in the clause
+unsigned Solver::shrinkLevel(unsigned level, unsigned open, unsigned pos) {
+  m_analyzeStack.clear();
+  unsigned uip = ~0u;
+  for (unsigned i = pos + 1; i-- > 0;) {
+    unsigned var = m_trail[i] / 2;
+    if (!m_seen[var]) continue;
+    if (open == 1) {
+      uip = m_trail[i];
+      if (m_seen[var] == 2) m_bumped.push_back(var);
+      break;
+    }
+
+    CRef reason = m_reason[var];
+    if (!isBinary(reason)) break;
+    open--;
+
+    unsigned other = (reason ^ CRefBinary) / 2;
+    if (m_seen[other] || m_level[other] == 0) continue;
+    if (m_level[other] != level) break;
+    m_seen[other] = 2;
+    m_analyzeStack.push_back(other);
+    open++;
+  }
+
+  for (unsigned var : m_analyzeStack) {
+    m_seen[var] = 0;
+  }
+  return uip;
+}
+
+void Solver::backtrack(unsigned level, bool savePhases) {
+  if (decisionLevel() <= level) return;
+
+  for (unsigned i = m_trail.size(); i > m_trailLim[level]; i--) {
+    unsigned var = m_trail[i - 1] / 2;
+    if (savePhases && m_opts.phaseSaving)
+      m_savedPhase[var] = !(m_trail[i - 1] % 2);
+    unassign(m_trail[i - 1]);
+    m_queue->unassigned(var);
+  }
+  m_trail.resize(m_trailLim[level]);
+  m_trailLim.resize(level);
+  m_qhead = m_trail.size();
+}
+
+void Solver::learn(const std::vector<unsigned> &learnt, unsigned lbd) {
+  if (m_learnCallback && learnt.size() <= m_learnMaxLength) {
+    std::vector<int> lits;
+    for (unsigned lit : learnt) {
+      lits.push_back(exportLit(lit));
+    }
+    if (std::find(lits.begin(), lits.end(), 0) == lits.end())
+      m_learnCallback(lits);
+  }
+
+  if (learnt.size() == 1) {
+    enqueue(learnt[0], CRefUndef);
+    return;
+  }
+
+  m_stats.learntClauses++;
+  if (learnt.size() == 2) {
+    m_binaries[learnt[0]].push_back(learnt[1]);
+    m_binaries[learnt[1]].push_back(learnt[0]);
+    enqueue(learnt[0], CRefBinary | learnt[1]);
+    return;
+  }
+
+  CRef cref = m_arena.alloc(learnt, true);
+  ArenaClause &clause = m_arena[cref];
+  clause.lbd = lbd;
+  clause.setTier(tierFor(lbd));
+  clause.setActivity(m_claInc);
+  m_learnts.push_back(cref);
+
+  m_watches[learnt[0]].push_back({cref, learnt[1]});
+  m_watches[learnt[1]].push_back({cref, learnt[0]});
+  enqueue(learnt[0], cref);
+}
+
+ClauseTier Solver::tierFor(unsigned lbd) const {
+  if (lbd <= m_opts.coreLBD) return ClauseTier::Core;
+  if (lbd <= m_opts.tier2LBD) return ClauseTier::Tier2;
+  return ClauseTier::Local;
+}
+
+// Learnt clauses taking part in conflict analysis gain activity and have their
+// LBD recomputed, since it can only have dropped since they were learnt
+void Solver::bumpClause(ArenaClause &clause) {
+  clause.used = 1;
+  clause.setActivity(clause.activity() + m_claInc);
+  if (clause.activity() > 1e20) {
+    for (CRef cref : m_learnts) {
+      m_arena[cref].setActivity(m_arena[cref].activity() * 1e-20);
+    }
+    m_claInc *= 1e-20;
+  }
+
+  if (clause.getTier() == ClauseTier::Core) return;
+  unsigned lbd = computeLBD(clause.begin(), clause.size);
+  if (lbd < clause.lbd) {
+    clause.lbd = lbd;
+    if (tierFor(lbd) < clause.getTier()) clause.setTier(tierFor(lbd));
+  }
+}
+
+// a clause is locked while it is the reason of its first literal
+bool Solver::locked(CRef cref) const {
+  unsigned lit = m_arena[cref][0];
+  return value(lit) == ValTrue && m_reason[lit / 2] == cref;
+}
+
+// Deleted clauses are only marked, their watches are dropped by cleanWatches
+// which only visits the watch lists of the two watched literals
+void Solver::deleteClause(CRef cref) {
+  m_arena.free(cref);
+  m_stats.deletedClauses++;
+  for (unsigned k = 0; k < 2; k++) {
+    unsigned lit = m_arena[cref][k];
+    if (!m_isDirty[lit]) {
+      m_isDirty[lit] = 1;
+      m_dirtyWatches.push_back(lit);
+    }
+  }
+}
+
+void Solver::cleanWatches() {
+  for (unsigned lit : m_dirtyWatches) {
+    auto &watches = m_watches[lit];
+    watches.erase(std::remove_if(watches.begin(), watches.end(),
+                                 [&](const Watch &w) {
+                                   return m_arena[w.cref].garbage;
+                                 }),
+                  watches.end());
+    m_isDirty[lit] = 0;
+  }
+  m_dirtyWatches.clear();
+}
+
+// Core clauses are never touched. Tier2 clauses that were not used since the
+// last reduction move to the local tier, and the less active half of the local
+// clauses is deleted
+void Solver::reduceDB() {
+  m_stats.reductions++;
+
+  std::vector<CRef> candidates;
+  for (CRef cref : m_learnts) {
+    ArenaClause &clause = m_arena[cref];
+    if (clause.getTier() == ClauseTier::Tier2 && !clause.used) {
+      clause.setTier(ClauseTier::Local);
+    } else if (clause.getTier() == ClauseTier::Local && !locked(cref)) {
+      candidates.push_back(cref);
+    }
+    clause.used = 0;
+  }
+
+  std::sort(candidates.begin(), candidates.end(), [&](CRef a, CRef b) {
+    return m_arena[a].activity() < m_arena[b].activity();
+  });
+  for (unsigned i = 0; i < candidates.size() / 2; i++) {
+    deleteClause(candidates[i]);
+  }
+
+  cleanWatches();
+  m_learnts.erase(std::remove_if(m_learnts.begin(), m_learnts.end(),
+                                 [&](CRef cref) {
+                                   return m_arena[cref].garbage;
+                                 }),
+                  m_learnts.end());
+
+  if (m_arena.wasted() > m_arena.size() * m_opts.garbageFraction)
+    collectGarbage();
 
-      auto &data = decisions.top();
-      auto idx = data.var;
-      while (!data.props.empty()) {
-        F->m_asgnMap[data.props.top()] = CNFFormula::Assignment::Empty;
-        data.props.pop();
+  m_reduceInterval += m_opts.reduceIncrement;
+  m_nextReduce = m_stats.conflicts + m_reduceInterval;
+}
+
+// Moves every live clause into a fresh arena and rewrites the references held
+// by the watch lists, the reasons on the trail and the clause lists. Watches
+// of deleted clauses have to be cleaned before
+void Solver::collectGarbage() {
+  m_stats.garbageCollections++;
+
+  ClauseArena to;
+  to.reserve(m_arena.size() - m_arena.wasted());
+
+  // relocating in watch order keeps clauses that are visited together close
+  for (auto &watches : m_watches) {
+    for (Watch &w : watches) {
+      m_arena.reloc(w.cref, to);
+    }
+  }
+  for (unsigned lit : m_trail) {
+    CRef &reason = m_reason[lit / 2];
+    if (reason != CRefUndef && !isBinary(reason)) m_arena.reloc(reason, to);
+  }
+  for (CRef &cref : m_learnts) {
+    m_arena.reloc(cref, to);
+  }
+  for (CRef &cref : m_clauses) {
+    m_arena.reloc(cref, to);
+  }
+
+  to.moveTo(m_arena);
+}
+
+// Bounded variable addition on the clauses of the formula before the solver
+// sets up anything per variable. Returns true and the new clauses, with the
+// units of the simplifier, only if fresh variables were added
+bool Solver::factor(const std::vector<Clause> &clauses,
+                    std::vector<Clause> &out) {
+  if (!m_opts.simp.factor) return false;
+
+  Simplifier simp(m_opts.simp, m_vals, m_eliminated, m_extension);
+  for (auto &clause : clauses) {
+    simp.addClause(clause);
+  }
+  simp.factor();
+  if (!simp.getStats().addedVars) return false;
+  m_stats.addedVars += simp.getStats().addedVars;
+  m_stats.factoredClauses += simp.getStats().factoredClauses;
+
+  simp.collect(out);
+  for (unsigned lit : simp.units()) {
+    out.push_back({lit});
+  }
+  m_numVars = m_eliminated.size();
+  m_vals.assign(m_numVars * 2, ValUnassigned);
+  return true;
+}
+
+// Runs the simplifier on the irredundant clauses at the root level. Binary
+// clauses are handed over as well, including learnt ones, since they are not
+// told apart from the irredundant ones. Its passes stop once they visited
+// clauses budget times
+bool Solver::simplify(uint64_t budget) {
+  // incremental solving only keeps the equivalence preserving passes
+  SimplifierOptions opts = m_opts.simp;
+  if (m_incremental) opts.block = opts.eliminate = false;
+  if (!opts.unhide && !opts.subsume && !opts.block && !opts.eliminate)
+    return true;
+
+  backtrack(0);
+  if (propagate() != CRefUndef) return false;
+
+  Simplifier simp(opts, m_vals, m_eliminated, m_extension);
+  simp.setTickLimit(budget);
+  Clause clause;
+  for (CRef cref : m_clauses) {
+    ArenaClause &c = m_arena[cref];
+    clause.assign(c.begin(), c.end());
+    simp.addClause(clause);
+  }
+  for (unsigned lit = 0; lit < m_binaries.size(); lit++) {
+    for (unsigned other : m_binaries[lit]) {
+      if (lit < other) simp.addClause({lit, other});
+    }
+  }
+
+  if (opts.unhide) simp.unhide();
+  if (opts.subsume) simp.subsume();
+  if (opts.block) simp.block();
+  if (opts.eliminate) simp.eliminate();
+  m_ticks += simp.ticks();
+  m_stats.subsumedClauses += simp.getStats().subsumedClauses;
+  m_stats.strengthenedClauses += simp.getStats().strengthenedClauses;
+  m_stats.eliminatedVars += simp.getStats().eliminatedVars;
+  m_stats.gateEliminations += simp.getStats().gateEliminations;
+  m_stats.hiddenTautologies += simp.getStats().hiddenTautologies;
+  m_stats.hiddenLiterals += simp.getStats().hiddenLiterals;
+  m_stats.blockedClauses += simp.getStats().blockedClauses;
+  m_stats.coveredClauses += simp.getStats().coveredClauses;
+  if (simp.unsat()) return false;
+
+  for (unsigned lit : simp.units()) {
+    if (value(lit) == ValUnassigned) enqueue(lit, CRefUndef);
+  }
+  std::vector<Clause> clauses;
+  simp.collect(clauses);
+  if (!replaceClauses(clauses)) return false;
+  return propagate() == CRefUndef;
+}
+
+// Swaps the irredundant clauses, binary ones included, for the given ones at
+// the root level
+bool Solver::replaceClauses(std::vector<Clause> &clauses) {
+  for (CRef cref : m_clauses) {
+    m_arena.free(cref);
+  }
+  m_clauses.clear();
+  for (auto &binaries : m_binaries) {
+    binaries.clear();
+  }
+
+  for (auto &clause : clauses) {
+    if (clause.size() == 2) {
+      m_binaries[clause[0]].push_back(clause[1]);
+      m_binaries[clause[1]].push_back(clause[0]);
+      continue;
+    }
+    m_clauses.push_back(m_arena.alloc(clause, false));
+  }
+  return rebuildWatches();
+}
+
+// Watches every clause in the arena again after clauses were changed in place
+// at the root level. Learnt clauses over eliminated variables, satisfied at
+// the root or deleted are dropped, and the others lose their root-false
+// literals. Returns false if a learnt clause became empty
+bool Solver::rebuildWatches() {
+  for (unsigned lit : m_trail) {
+    m_reason[lit / 2] = CRefUndef;
+  }
+  for (auto &watches : m_watches) {
+    watches.clear();
+  }
+  for (unsigned lit : m_dirtyWatches) {
+    m_isDirty[lit] = 0;
+  }
+  m_dirtyWatches.clear();
+
+  auto attach = [&](CRef cref) {
+    ArenaClause &clause = m_arena[cref];
+    m_watches[clause[0]].push_back({cref, clause[1]});
+    m_watches[clause[1]].push_back({cref, clause[0]});
+  };
+  for (CRef cref : m_clauses) {
+    attach(cref);
+  }
+
+  bool unsat = false;
+  unsigned j = 0;
+  for (CRef cref : m_learnts) {
+    ArenaClause &clause = m_arena[cref];
+    if (clause.garbage) continue;
+
+    bool remove = false;
+    unsigned size = 0;
+    for (unsigned lit : clause) {
+      if (m_eliminated[lit / 2] || value(lit) == ValTrue) {
+        remove = true;
+        break;
       }
+      if (value(lit) == ValUnassigned) clause[size++] = lit;
+    }
 
-      if (F->m_asgnMap[idx] == CNFFormula::Assignment::False) {
-        F->m_asgnMap[idx] = CNFFormula::Assignment::True;
-        i = data.var;
-        conflict = false;
-        unitProp(decisions.top());
-      } else {
-        // top-level conflict
-        if (decisions.size() == 1) return false;
-
-        F->m_asgnMap[idx] = CNFFormula::Assignment::Empty;
-        decisions.pop();
-        i = decisions.top().var;
+    if (remove || size < 3) {
+      if (!remove && size == 2) {
+        m_binaries[clause[0]].push_back(clause[1]);
+        m_binaries[clause[1]].push_back(clause[0]);
       }
+      if (!remove && size == 1) enqueue(clause[0], CRefUndef);
+      if (!remove && size == 0) unsat = true;
+      m_arena.free(cref);
+      m_stats.deletedClauses++;
+      continue;
+    }
+    m_arena.shrink(cref, size);
+    attach(cref);
+    m_learnts[j++] = cref;
+  }
+  m_learnts.resize(j);
+
+  collectGarbage();
+  return !unsat;
+}
+
+// The solver assigned every variable but the eliminated ones, which start out
+// false and are then fixed by the extension stack. The model is a copy, so
+// the trail stays consistent with the values
+void Solver::extendModel() {
+  m_model = m_vals;
+  for (unsigned var = 0; var < m_numVars; var++) {
+    if (m_model[var * 2] != ValUnassigned) continue;
+    m_model[var * 2] = ValFalse;
+    m_model[var * 2 + 1] = ValTrue;
+  }
+  m_extension.extend(m_model);
+}
+
+void Solver::initQueues() {
+  m_staticQueue.init(m_numVars);
+  m_heapQueue.init(m_numVars);
+  m_vmtfQueue.init(m_numVars);
+
+  m_stable = false;
+  switch (m_opts.heuristic) {
+  case DecisionHeuristic::Static:
+    m_queue = &m_staticQueue;
+    break;
+  case DecisionHeuristic::VSIDS:
+    m_stable = true;
+    m_queue = &m_heapQueue;
+    break;
+  case DecisionHeuristic::VMTF:
+  case DecisionHeuristic::Alternating:
+    m_queue = &m_vmtfQueue;
+    break;
+  }
+
+  m_switchInterval = m_opts.modeSwitchConflicts;
+  m_nextSwitch = m_switchInterval;
+}
+
+// Toggles between focused and stable mode. The queue we switch to was not
+// told about unassignments while it was inactive, so every unassigned
+// variable is handed to it again
+void Solver::switchMode() {
+  backtrack(0);
+  m_stats.modeSwitches++;
+
+  m_stable = !m_stable;
+  m_queue = m_stable ? static_cast<AbstractDecisionQueue *>(&m_heapQueue)
+                     : &m_vmtfQueue;
+  for (unsigned var = 0; var < m_numVars; var++) {
+    if (value(var * 2) == ValUnassigned) m_queue->unassigned(var);
+  }
+
+  // each pair of focused and stable phases is longer than the last
+  if (!m_stable) {
+    m_switchInterval = m_switchInterval * m_opts.modeSwitchGrowth;
+  }
+  m_nextSwitch = m_stats.conflicts + m_switchInterval;
+
+  selectRestartPolicy();
+}
+
+bool Solver::pickBranchVar(unsigned &var) {
+  while (m_queue->next(var)) {
+    if (value(var * 2) == ValUnassigned && !m_eliminated[var]) return true;
+  }
+  return false;
+}
+
+unsigned Solver::decisionLit(unsigned var) const {
+  bool phase = m_savedPhase[var];
+  if (m_stable && m_opts.targetPhases && m_targetAssigned)
+    phase = m_targetPhase[var];
+  return var * 2 + !phase;
+}
+
+void Solver::initPhases() {
+  m_savedPhase.assign(m_numVars, m_opts.initialPhase);
+  m_targetPhase = m_savedPhase;
+  m_bestPhase = m_savedPhase;
+  m_targetAssigned = 0;
+  m_bestAssigned = 0;
+  m_nextRephase = m_opts.rephaseConflicts;
+  m_random = m_opts.seed;
+}
+
+// Called with the size of the conflict-free trail prefix before backjumping.
+// Only the prefix is copied, variables beyond it keep their previous phase
+void Solver::updatePhases(unsigned assigned) {
+  if (m_stable && assigned > m_targetAssigned) {
+    for (unsigned i = 0; i < assigned; i++) {
+      m_targetPhase[m_trail[i] / 2] = !(m_trail[i] % 2);
+    }
+    m_targetAssigned = assigned;
+  }
+  if (assigned > m_bestAssigned) {
+    for (unsigned i = 0; i < assigned; i++) {
+      m_bestPhase[m_trail[i] / 2] = !(m_trail[i] % 2);
     }
+    m_bestAssigned = assigned;
+  }
+}
+
+// Overwrites the saved phases so the search continues from a different part
+// of the search space. Best phases are interleaved with the others so we keep
+// returning to the most promising assignment found so far
+void Solver::rephase() {
+  enum class Rephase { Original, Best, Inverted, Random };
+  static const Rephase schedule[] = {Rephase::Original, Rephase::Best,
+                                     Rephase::Inverted, Rephase::Best,
+                                     Rephase::Random,   Rephase::Best};
+  static const unsigned scheduleSize = sizeof(schedule) / sizeof(schedule[0]);
+
+  switch (schedule[m_stats.rephases % scheduleSize]) {
+  case Rephase::Original:
+    std::fill(m_savedPhase.begin(), m_savedPhase.end(), m_opts.initialPhase);
+    break;
+  case Rephase::Inverted:
+    std::fill(m_savedPhase.begin(), m_savedPhase.end(), !m_opts.initialPhase);
+    break;
+  case Rephase::Best:
+    if (m_bestAssigned) m_savedPhase = m_bestPhase;
+    m_bestAssigned = 0;
+    break;
+  case Rephase::Random:
+    for (char &phase : m_savedPhase) {
+      phase = nextRandom() >> 63;
+    }
+    break;
+  }
+
+  m_targetPhase = m_savedPhase;
+  m_targetAssigned = 0;
+
+  m_stats.rephases++;
+  m_nextRephase =
+      m_stats.conflicts + m_opts.rephaseConflicts * (m_stats.rephases + 1);
+}
+
+// splitmix64, which is plenty for picking phases and keeps runs reproducible
+uint64_t Solver::nextRandom() {
+  uint64_t z = (m_random += 0x9e3779b97f4a7c15ull);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  return z ^ (z >> 31);
+}
+
+// number of distinct decision levels among lits
+unsigned Solver::computeLBD(const unsigned *lits, unsigned size) {
+  m_lbdStamp++;
+  unsigned lbd = 0;
+  for (unsigned k = 0; k < size; k++) {
+    unsigned level = m_level[lits[k] / 2];
+    if (m_levelStamp[level] != m_lbdStamp) {
+      m_levelStamp[level] = m_lbdStamp;
+      lbd++;
+    }
+  }
+  return lbd;
+}
+
+void Solver::initRestarts() {
+  m_luby.init();
+  m_stableLuby.init();
+  m_glucose.init();
+  m_levelStamp.assign(m_numVars + 1, 0);
+  m_lbdStamp = 0;
+  selectRestartPolicy();
+}
+
+void Solver::selectRestartPolicy() {
+  switch (m_opts.restarts) {
+  case RestartStrategy::None:
+    m_restart = nullptr;
+    break;
+  case RestartStrategy::Luby:
+    m_restart = &m_luby;
+    break;
+  case RestartStrategy::Glucose:
+    m_restart = &m_glucose;
+    break;
+  case RestartStrategy::ByMode:
+    m_restart = m_stable ? static_cast<AbstractRestartPolicy *>(&m_stableLuby)
+                         : &m_glucose;
+    break;
+  }
+  if (m_restart) m_restart->resumed();
+}
+
+// Returns the lowest decision level whose decision would not be repeated
+// right after restarting: every decision below it has a higher priority than
+// the next candidate of the queue, so the solver would take it again anyway
+unsigned Solver::reuseTrailLevel() {
+  unsigned next;
+  if (!pickBranchVar(next)) return decisionLevel();
+  m_queue->unassigned(next);
+
+  // the assumptions are decided again the same way, and their levels may be
+  // empty
+  unsigned level = std::min<unsigned>(m_assumptions.size(), decisionLevel());
+  while (level < decisionLevel() &&
+         m_queue->before(m_trail[m_trailLim[level]] / 2, next)) {
+    level++;
+  }
+  return level;
+}
+
+void Solver::restart() {
+  m_stats.restarts++;
+
+  unsigned level = m_opts.reuseTrail ? reuseTrailLevel() : 0;
+  if (level) m_stats.reusedTrails++;
+  backtrack(level);
+
+  m_restart->restarted();
+}
+
+// Sets up the trail and the decision queues and assigns the unit clauses at
+// level 0. Returns false if the units contradict each other
+bool Solver::initSearch() {
+  m_level.assign(m_numVars, 0);
+  m_reason.assign(m_numVars, CRefUndef);
+  m_trailPos.assign(m_numVars, 0);
+  m_seen.assign(m_numVars, 0);
+  m_trail.clear();
+  m_trail.reserve(m_numVars);
+  m_trailLim.clear();
+  m_qhead = 0;
+
+  m_claInc = 1.0;
+  m_reduceInterval = m_opts.reduceConflicts;
+  m_nextReduce = m_reduceInterval;
+  m_ticks = 0;
+  m_probeNext = 0;
+
+  initQueues();
+  initPhases();
+  initRestarts();
+
+  for (unsigned lit : m_units) {
+    int8_t val = value(lit);
+    if (val == ValFalse) return false;
+    if (val == ValUnassigned) enqueue(lit, CRefUndef);
   }
   return true;
 }
 
+SolveResult Solver::CDCL() {
+  std::vector<unsigned> learnt;
+  while (true) {
+    CRef conflict = propagate();
+
+    if (conflict != CRefUndef) {
+      m_stats.conflicts++;
+      if (decisionLevel() == 0) return SolveResult::Unsat;
+      if (m_terminate && m_terminate()) return SolveResult::Unknown;
+
+      updatePhases(m_trailLim.back());
+
+      unsigned btLevel;
+      analyze(conflict, learnt, btLevel);
+      unsigned lbd = computeLBD(learnt.data(), learnt.size());
+      if (m_restart) m_restart->conflict(lbd, m_trail.size());
+      m_queue->bump(m_bumped);
+      backtrack(btLevel);
+      learn(learnt, lbd);
+      m_claInc /= m_opts.clauseDecay;
+
+      if (m_opts.heuristic == DecisionHeuristic::Alternating &&
+          m_stats.conflicts >= m_nextSwitch)
+        switchMode();
+      if (m_opts.rephaseConflicts && m_stats.conflicts >= m_nextRephase)
+        rephase();
+      if (m_restart && m_restart->shouldRestart()) restart();
+      if (m_stats.conflicts >= m_nextReduce) reduceDB();
+      if (!inprocess()) return SolveResult::Unsat;
+      continue;
+    }
+
+    // the assumptions come first, one per level. One that is already true
+    // gets an empty level so the levels and assumptions stay aligned
+    unsigned decision = NoLiteral;
+    while (decisionLevel() < m_assumptions.size() && decision == NoLiteral) {
+      unsigned lit = m_assumptions[decisionLevel()];
+      if (value(lit) == ValFalse) {
+        analyzeFinal(lit);
+        return SolveResult::Unsat;
+      }
+      if (value(lit) == ValTrue) m_trailLim.push_back(m_trail.size());
+      else decision = lit;
+    }
+    if (decision == NoLiteral) {
+      unsigned var;
+      if (!pickBranchVar(var)) return SolveResult::Sat;
+      decision = decisionLit(var);
+    }
+
+    m_stats.decisions++;
+    m_trailLim.push_back(m_trail.size());
+    enqueue(decision, CRefUndef);
+  }
+}
+
 } // namespace vasSAT
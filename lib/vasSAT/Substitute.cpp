@@ -0,0 +1,176 @@
+#include "vasSAT/Solver.hpp"
+#include <algorithm>
+
+namespace vasSAT {
+
+// Tarjan's algorithm on the binary implication graph, with an explicit stack
+// of (literal, next edge) frames instead of recursion. Every literal in a
+// strongly connected component is equivalent to the others, and the literal
+// of the smallest variable represents them. The complementary component then
+// has the negated representative, so repr[lit ^ 1] == repr[lit] ^ 1. Returns
+// false if a literal and its negation end up in the same component
+bool Solver::findEquivalences(std::vector<unsigned> &repr) {
+  constexpr unsigned Unvisited = ~0u;
+  unsigned numLits = m_numVars * 2;
+  std::vector<unsigned> index(numLits, Unvisited);
+  std::vector<unsigned> low(numLits);
+  std::vector<char> onStack(numLits, 0);
+  std::vector<unsigned> stack;
+  std::vector<std::pair<unsigned, unsigned>> frames;
+  unsigned counter = 0;
+
+  repr.resize(numLits);
+  for (unsigned lit = 0; lit < numLits; lit++) {
+    repr[lit] = lit;
+  }
+  auto active = [&](unsigned lit) {
+    return !m_eliminated[lit / 2] && value(lit) == ValUnassigned;
+  };
+  auto visit = [&](unsigned lit) {
+    index[lit] = low[lit] = counter++;
+    stack.push_back(lit);
+    onStack[lit] = 1;
+    frames.push_back({lit, 0});
+  };
+
+  for (unsigned root = 0; root < numLits; root++) {
+    if (index[root] != Unvisited || !active(root)) continue;
+    visit(root);
+
+    while (!frames.empty()) {
+      unsigned lit = frames.back().first;
+      // the successors of lit are the literals implied once lit is true
+      auto &succs = m_binaries[lit ^ 1];
+      if (frames.back().second < succs.size()) {
+        unsigned next = succs[frames.back().second++];
+        m_ticks++;
+        if (!active(next)) continue;
+        if (index[next] == Unvisited) visit(next);
+        else if (onStack[next]) low[lit] = std::min(low[lit], index[next]);
+        continue;
+      }
+
+      frames.pop_back();
+      if (!frames.empty()) {
+        unsigned parent = frames.back().first;
+        low[parent] = std::min(low[parent], low[lit]);
+      }
+      if (low[lit] != index[lit]) continue;
+
+      // the component is the top of the stack from lit up, so the search
+      // starts there and costs its size only
+      auto first = std::find(stack.rbegin(), stack.rend(), lit).base() - 1;
+      unsigned best = lit;
+      for (auto it = first; it != stack.end(); it++) {
+        if (*it / 2 < best / 2) best = *it;
+      }
+      for (auto it = first; it != stack.end(); it++) {
+        onStack[*it] = 0;
+        repr[*it] = best;
+      }
+      // a complementary component is popped later, unless it is this one
+      for (auto it = first; it != stack.end(); it++) {
+        if (repr[*it ^ 1] == best) return false;
+      }
+      stack.erase(first, stack.end());
+    }
+  }
+  return true;
+}
+
+// Replaces every literal by the representative of its equivalence class, in
+// the arena clauses in place and in the binary clauses. The substituted
+// variables are removed from the search like eliminated ones, and the two
+// binary clauses defining each of them go onto the extension stack
+bool Solver::substitute() {
+  if (!m_opts.substitute || m_incremental) return true;
+
+  backtrack(0);
+  if (propagate() != CRefUndef) return false;
+
+  std::vector<unsigned> repr;
+  if (!findEquivalences(repr)) return false;
+
+  bool found = false;
+  for (unsigned var = 0; var < m_numVars; var++) {
+    unsigned lit = var * 2;
+    if (repr[lit] == lit) continue;
+    found = true;
+    m_eliminated[var] = 1;
+    m_stats.substitutedVars++;
+    m_extension.push(lit, {lit, repr[lit] ^ 1});
+    m_extension.push(lit ^ 1, {lit ^ 1, repr[lit]});
+  }
+  if (!found) return true;
+
+  // substitutes the literals of a clause, dropping duplicate and root-false
+  // ones. Returns false if the clause became satisfied or a tautology
+  std::vector<char> marks(m_numVars * 2, 0);
+  std::vector<unsigned> units;
+  auto rewrite = [&](unsigned *lits, unsigned &size) {
+    unsigned j = 0;
+    bool keep = true;
+    for (unsigned k = 0; k < size && keep; k++) {
+      unsigned lit = repr[lits[k]];
+      if (value(lit) == ValTrue || marks[lit ^ 1]) keep = false;
+      else if (value(lit) == ValUnassigned && !marks[lit]) {
+        marks[lit] = 1;
+        lits[j++] = lit;
+      }
+    }
+    for (unsigned k = 0; k < j; k++) {
+      marks[lits[k]] = 0;
+    }
+    size = j;
+    return keep;
+  };
+
+  std::vector<std::vector<unsigned>> binaries(m_numVars * 2);
+  auto addClause = [&](unsigned *lits, unsigned size) {
+    if (size == 0) return false;
+    if (size == 1) units.push_back(lits[0]);
+    if (size == 2) {
+      binaries[lits[0]].push_back(lits[1]);
+      binaries[lits[1]].push_back(lits[0]);
+    }
+    return true;
+  };
+
+  bool unsat = false;
+  for (auto *crefs : {&m_clauses, &m_learnts}) {
+    unsigned j = 0;
+    for (CRef cref : *crefs) {
+      ArenaClause &clause = m_arena[cref];
+      if (clause.garbage) continue;
+      unsigned size = clause.size;
+      bool keep = rewrite(clause.begin(), size);
+      if (keep && size >= 3) {
+        m_arena.shrink(cref, size);
+        (*crefs)[j++] = cref;
+        continue;
+      }
+      if (keep && !addClause(clause.begin(), size)) unsat = true;
+      m_arena.free(cref);
+    }
+    crefs->resize(j);
+  }
+
+  for (unsigned lit = 0; lit < m_numVars * 2; lit++) {
+    for (unsigned other : m_binaries[lit]) {
+      if (lit > other) continue;
+      unsigned binary[2] = {lit, other};
+      unsigned size = 2;
+      if (rewrite(binary, size) && !addClause(binary, size)) unsat = true;
+    }
+  }
+  m_binaries.swap(binaries);
+
+  if (unsat || !rebuildWatches()) return false;
+  for (unsigned lit : units) {
+    if (value(lit) == ValFalse) return false;
+    if (value(lit) == ValUnassigned) enqueue(lit, CRefUndef);
+  }
+  return propagate() == CRefUndef;
+}
+
+} // namespace vasSAT
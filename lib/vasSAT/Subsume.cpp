@@ -0,0 +1,196 @@
+#include "vasSAT/Occurrences.hpp"
+#include "vasSAT/Simplifier.hpp"
+#include "vasSAT/Solver.hpp"
+#include <algorithm>
+
+namespace vasSAT {
+
+// Removes lit from the clause. A clause strengthened to a unit is removed and
+// its literal assigned
+void Simplifier::strengthen(unsigned idx, unsigned lit) {
+  Clause &clause = m_clauses[idx];
+  clause.erase(std::find(clause.begin(), clause.end(), lit));
+  auto &occurs = m_occurs[lit];
+  occurs.erase(std::find(occurs.begin(), occurs.end(), idx));
+  m_stats.strengthenedClauses++;
+
+  if (clause.size() > 1) return;
+  unsigned unit = clause[0];
+  removeClause(idx);
+  assign(unit);
+  propagate();
+}
+
+// Backward subsumption: every clause, shortest first, looks for the clauses
+// it subsumes or strengthens among the occurrences of its least frequent
+// variable. Strengthened clauses are queued again since they may subsume
+// others now
+void Simplifier::subsume() {
+  if (!propagate()) return;
+
+  unsigned numClauses = m_clauses.size();
+  OccurrenceTable occs;
+  occs.init(m_vals.size());
+  for (unsigned idx = 0; idx < numClauses; idx++) {
+    if (m_removed[idx]) continue;
+    for (unsigned lit : m_clauses[idx]) {
+      occs.count(lit);
+    }
+  }
+  occs.allocate();
+
+  std::vector<uint64_t> signatures(numClauses);
+  std::vector<unsigned> queue;
+  for (unsigned idx = 0; idx < numClauses; idx++) {
+    if (m_removed[idx]) continue;
+    const Clause &clause = m_clauses[idx];
+    for (unsigned lit : clause) {
+      occs.add(lit, idx);
+    }
+    signatures[idx] = clauseSignature(clause.data(), clause.size());
+    queue.push_back(idx);
+  }
+  std::stable_sort(queue.begin(), queue.end(), [&](unsigned a, unsigned b) {
+    return m_clauses[a].size() < m_clauses[b].size();
+  });
+
+  std::vector<char> queued(numClauses, 1);
+  for (unsigned i = 0; i < queue.size() && !m_unsat && m_ticks < m_tickLimit;
+       i++) {
+    unsigned c = queue[i];
+    queued[c] = 0;
+    if (m_removed[c] || m_clauses[c].size() > m_opts.subsumeClauseSize)
+      continue;
+
+    unsigned best = m_clauses[c][0];
+    for (unsigned lit : m_clauses[c]) {
+      if (occs.size(lit) + occs.size(lit ^ 1) <
+          occs.size(best) + occs.size(best ^ 1))
+        best = lit;
+    }
+
+    for (unsigned lit : {best, best ^ 1}) {
+      for (auto it = occs.begin(lit); it != occs.end(lit); it++) {
+        unsigned d = *it;
+        // propagating a unit may have removed c as well
+        if (m_removed[c]) break;
+        if (d == c || m_removed[d]) continue;
+
+        const Clause &clause = m_clauses[c];
+        const Clause &other = m_clauses[d];
+        m_ticks++;
+        if (other.size() < clause.size() || (signatures[c] & ~signatures[d]))
+          continue;
+        m_ticks += other.size();
+
+        unsigned res = subsumes(clause.data(), clause.size(), other.data(),
+                                other.size(), m_marks);
+        if (res == NotSubsumed) continue;
+        if (res == Subsumed) {
+          m_stats.subsumedClauses++;
+          removeClause(d);
+          continue;
+        }
+
+        strengthen(d, res ^ 1);
+        if (m_removed[d]) continue;
+        signatures[d] = clauseSignature(other.data(), other.size());
+        if (!queued[d]) {
+          queued[d] = 1;
+          queue.push_back(d);
+        }
+      }
+    }
+  }
+}
+
+// Subsumes and strengthens the learnt clauses at the root level, using the
+// binary clauses and every clause in the arena. A learnt clause subsuming
+// another one takes over its tier if that is better. Clauses are strengthened
+// in place, so all watches are rebuilt afterwards. Stops once the candidates
+// visited add up to the budget
+bool Solver::subsumeLearnts(uint64_t budget) {
+  backtrack(0);
+  if (propagate() != CRefUndef) return false;
+
+  std::vector<CRef> learnts = m_learnts;
+  OccurrenceTable occs;
+  occs.init(m_numVars * 2);
+  for (CRef cref : learnts) {
+    for (unsigned lit : m_arena[cref]) {
+      occs.count(lit);
+    }
+  }
+  occs.allocate();
+
+  std::vector<uint64_t> signatures(learnts.size());
+  for (unsigned idx = 0; idx < learnts.size(); idx++) {
+    ArenaClause &clause = m_arena[learnts[idx]];
+    for (unsigned lit : clause) {
+      occs.add(lit, idx);
+    }
+    signatures[idx] = clauseSignature(clause.begin(), clause.size);
+  }
+
+  std::vector<char> marks(m_numVars * 2, 0);
+  auto subsumeWith = [&](const unsigned *lits, unsigned size, CRef from) {
+    unsigned best = lits[0];
+    for (unsigned k = 1; k < size; k++) {
+      if (occs.size(lits[k]) + occs.size(lits[k] ^ 1) <
+          occs.size(best) + occs.size(best ^ 1))
+        best = lits[k];
+    }
+    uint64_t sig = clauseSignature(lits, size);
+
+    for (unsigned lit : {best, best ^ 1}) {
+      for (auto it = occs.begin(lit); it != occs.end(lit); it++) {
+        CRef cref = learnts[*it];
+        ArenaClause &other = m_arena[cref];
+        m_ticks++;
+        if (cref == from || other.garbage || other.size < size ||
+            (sig & ~signatures[*it]))
+          continue;
+        m_ticks += other.size;
+
+        unsigned res = subsumes(lits, size, other.begin(), other.size, marks);
+        if (res == NotSubsumed) continue;
+        if (res == Subsumed) {
+          if (from != CRefUndef && m_arena[from].learnt &&
+              other.getTier() < m_arena[from].getTier())
+            m_arena[from].setTier(other.getTier());
+          m_stats.subsumedClauses++;
+          deleteClause(cref);
+          continue;
+        }
+
+        unsigned *pos = std::find(other.begin(), other.end(), res ^ 1);
+        *pos = other[other.size - 1];
+        m_arena.shrink(cref, other.size - 1);
+        signatures[*it] = clauseSignature(other.begin(), other.size);
+        m_stats.strengthenedClauses++;
+      }
+    }
+  };
+
+  uint64_t limit = m_ticks + budget;
+  for (unsigned lit = 0; lit < m_numVars * 2 && m_ticks < limit; lit++) {
+    for (unsigned other : m_binaries[lit]) {
+      unsigned binary[2] = {lit, other};
+      if (lit < other) subsumeWith(binary, 2, CRefUndef);
+    }
+  }
+  for (auto *crefs : {&m_clauses, &learnts}) {
+    for (CRef cref : *crefs) {
+      if (m_ticks >= limit) break;
+      ArenaClause &clause = m_arena[cref];
+      if (clause.garbage || clause.size > m_opts.simp.subsumeClauseSize)
+        continue;
+      subsumeWith(clause.begin(), clause.size, cref);
+    }
+  }
+
+  if (!rebuildWatches()) return false;
+  return propagate() == CRefUndef;
+}
+
+} // namespace vasSAT
@@ -0,0 +1,117 @@
+#include "vasSAT/Simplifier.hpp"
+#include <algorithm>
+
+namespace vasSAT {
+
+// Depth first search over the binary implication graph, where a binary clause
+// (a b) is an edge from the negation of a to b and from the negation of b to
+// a. Each literal gets the time the search discovered and finished it, and u
+// implies v whenever v was discovered after and finished before u, as v then
+// lies below u in the search tree. Literals without incoming edges are the
+// roots of the search, every other unstamped literal starts one afterwards.
+// Each edge visited costs a tick, and the search gives up once the ticks pass
+// limit
+bool Simplifier::stamp(std::vector<unsigned> &discovered,
+                       std::vector<unsigned> &finished, uint64_t limit) {
+  unsigned numLits = m_vals.size();
+  discovered.assign(numLits, 0);
+  finished.assign(numLits, 0);
+  unsigned time = 0;
+  std::vector<std::pair<unsigned, unsigned>> frames;
+
+  auto active = [&](unsigned lit) {
+    return !m_eliminated[lit / 2] && !m_vals[lit];
+  };
+  auto root = [&](unsigned lit) {
+    for (unsigned idx : m_occurs[lit]) {
+      if (!m_removed[idx] && m_clauses[idx].size() == 2) return false;
+    }
+    return true;
+  };
+  auto search = [&](unsigned start) {
+    discovered[start] = ++time;
+    frames.push_back({start, 0});
+    while (!frames.empty()) {
+      if (m_ticks > limit) return false;
+      unsigned lit = frames.back().first;
+      // the clauses with the negation of lit hold its successors
+      auto &occurs = m_occurs[lit ^ 1];
+      if (frames.back().second == occurs.size()) {
+        finished[lit] = ++time;
+        frames.pop_back();
+        continue;
+      }
+
+      unsigned idx = occurs[frames.back().second++];
+      m_ticks++;
+      const Clause &clause = m_clauses[idx];
+      if (m_removed[idx] || clause.size() != 2) continue;
+      unsigned next = clause[0] == (lit ^ 1) ? clause[1] : clause[0];
+      if (discovered[next]) continue;
+      discovered[next] = ++time;
+      frames.push_back({next, 0});
+    }
+    return true;
+  };
+
+  for (bool roots : {true, false}) {
+    for (unsigned lit = 0; lit < numLits; lit++) {
+      if (discovered[lit] || !active(lit) || (roots && !root(lit))) continue;
+      if (!search(lit)) return false;
+    }
+  }
+  return true;
+}
+
+// Hidden tautology and hidden literal elimination. A clause with literals a
+// and b where the negation of a implies b is implied by the binary clauses
+// and removed. A literal implying another literal of its clause is removed
+// from it. Binary clauses form the graph and are only strengthened, and the
+// whole pass, stamping included, stops once it used up its ticks
+void Simplifier::unhide() {
+  if (!propagate()) return;
+
+  std::vector<unsigned> discovered, finished;
+  uint64_t limit = std::min(m_ticks + m_opts.unhideTicks, m_tickLimit);
+  if (!stamp(discovered, finished, limit)) return;
+
+  auto implies = [&](unsigned u, unsigned v) {
+    return discovered[u] < discovered[v] && finished[v] < finished[u];
+  };
+
+  for (unsigned idx = 0; idx < m_clauses.size() && !m_unsat; idx++) {
+    if (m_ticks > limit) break;
+    if (m_removed[idx]) continue;
+    const Clause &clause = m_clauses[idx];
+    m_ticks += clause.size() * clause.size();
+
+    bool tautology = false;
+    for (unsigned i = 0; i < clause.size() && clause.size() > 2; i++) {
+      for (unsigned j = 0; j < clause.size() && !tautology; j++) {
+        tautology = i != j && implies(clause[i] ^ 1, clause[j]);
+      }
+      if (tautology) break;
+    }
+    if (tautology) {
+      m_stats.hiddenTautologies++;
+      removeClause(idx);
+      continue;
+    }
+
+    // a strengthened clause may turn into a unit, which removes it
+    for (unsigned i = 0; i < clause.size() && !m_removed[idx];) {
+      bool hidden = false;
+      for (unsigned j = 0; j < clause.size() && !hidden; j++) {
+        hidden = i != j && implies(clause[i], clause[j]);
+      }
+      if (!hidden) {
+        i++;
+        continue;
+      }
+      m_stats.hiddenLiterals++;
+      strengthen(idx, clause[i]);
+    }
+  }
+}
+
+} // namespace vasSAT
@@ -0,0 +1,68 @@
+#include "vasSAT/VarHeap.hpp"
+
+namespace vasSAT {
+
+void VarHeap::siftUp(unsigned idx) {
+  unsigned var = m_heap[idx];
+  while (idx > 0) {
+    unsigned parent = (idx - 1) / 2;
+    if (!less(m_heap[parent], var)) break;
+
+    m_heap[idx] = m_heap[parent];
+    m_indices[m_heap[idx]] = idx;
+    idx = parent;
+  }
+  m_heap[idx] = var;
+  m_indices[var] = idx;
+}
+
+void VarHeap::siftDown(unsigned idx) {
+  unsigned var = m_heap[idx];
+  while (2 * idx + 1 < m_heap.size()) {
+    unsigned child = 2 * idx + 1;
+    if (child + 1 < m_heap.size() && less(m_heap[child], m_heap[child + 1]))
+      child++;
+    if (!less(var, m_heap[child])) break;
+
+    m_heap[idx] = m_heap[child];
+    m_indices[m_heap[idx]] = idx;
+    idx = child;
+  }
+  m_heap[idx] = var;
+  m_indices[var] = idx;
+}
+
+void VarHeap::clear() {
+  for (unsigned var : m_heap) {
+    m_indices[var] = -1;
+  }
+  m_heap.clear();
+}
+
+void VarHeap::insert(unsigned var) {
+  if (var >= m_indices.size()) m_indices.resize(var + 1, -1);
+  if (contains(var)) return;
+
+  m_indices[var] = m_heap.size();
+  m_heap.push_back(var);
+  siftUp(m_heap.size() - 1);
+}
+
+void VarHeap::increase(unsigned var) {
+  if (contains(var)) siftUp(m_indices[var]);
+}
+
+unsigned VarHeap::pop() {
+  unsigned var = m_heap[0];
+  m_indices[var] = -1;
+
+  m_heap[0] = m_heap.back();
+  m_heap.pop_back();
+  if (!m_heap.empty()) {
+    m_indices[m_heap[0]] = 0;
+    siftDown(0);
+  }
+  return var;
+}
+
+} // namespace vasSAT
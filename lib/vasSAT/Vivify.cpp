@@ -0,0 +1,183 @@
+#include "vasSAT/Solver.hpp"
+#include <algorithm>
+
+namespace vasSAT {
+
+void Solver::detachClause(CRef cref) {
+  ArenaClause &clause = m_arena[cref];
+  for (unsigned k = 0; k < 2; k++) {
+    auto &watches = m_watches[clause[k]];
+    m_ticks += watches.size();
+    watches.erase(std::find_if(watches.begin(), watches.end(),
+                               [&](const Watch &w) { return w.cref == cref; }));
+  }
+}
+
+// Assigns the negations of the literals of the clause one at a time, sharing
+// the decisions with the previous clause where their literals agree, while
+// the clause itself is detached. A literal already false is implied false by
+// the decisions before it and can be dropped. A literal already true, or a
+// conflict, means the decisions so far (with that literal) form a clause the
+// other clauses imply, which replaces this one. Returns false on a root
+// conflict
+bool Solver::vivifyClause(CRef cref, const std::vector<unsigned> &lits) {
+  ArenaClause &clause = m_arena[cref];
+  if (locked(cref)) backtrack(m_level[clause[0] / 2] - 1, false);
+  detachClause(cref);
+
+  unsigned level = 0;
+  for (unsigned lit : lits) {
+    if (level == decisionLevel()) break;
+    if (value(lit) == ValFalse && m_level[lit / 2] <= level) continue;
+    if (m_trail[m_trailLim[level]] != (lit ^ 1)) break;
+    level++;
+  }
+  backtrack(level, false);
+
+  unsigned implied = NoLiteral;
+  bool conflict = false;
+  for (unsigned lit : lits) {
+    int8_t val = value(lit);
+    if (val == ValFalse) continue;
+    if (val == ValTrue) {
+      implied = lit;
+      break;
+    }
+    m_trailLim.push_back(m_trail.size());
+    enqueue(lit ^ 1, CRefUndef);
+    if (propagate() != CRefUndef) {
+      conflict = true;
+      break;
+    }
+  }
+
+  std::vector<unsigned> vivified;
+  for (unsigned lim : m_trailLim) {
+    vivified.push_back(m_trail[lim] ^ 1);
+  }
+  if (conflict) backtrack(decisionLevel() - 1, false);
+
+  // satisfied at the root level
+  if (implied != NoLiteral && m_level[implied / 2] == 0) {
+    m_arena.free(cref);
+    m_stats.deletedClauses++;
+    return true;
+  }
+  if (implied != NoLiteral) {
+    // only the decisions up to its level imply it
+    vivified.resize(m_level[implied / 2]);
+    vivified.push_back(implied);
+  }
+  if (vivified.size() == clause.size) {
+    m_watches[clause[0]].push_back({cref, clause[1]});
+    m_watches[clause[1]].push_back({cref, clause[0]});
+    return true;
+  }
+
+  m_stats.vivifiedClauses++;
+  m_stats.vivifiedLiterals += clause.size - vivified.size();
+  backtrack(0, false);
+  if (vivified.size() <= 2) {
+    m_arena.free(cref);
+    if (vivified.size() == 2) {
+      m_binaries[vivified[0]].push_back(vivified[1]);
+      m_binaries[vivified[1]].push_back(vivified[0]);
+      return true;
+    }
+    enqueue(vivified[0], CRefUndef);
+    return propagate() == CRefUndef;
+  }
+
+  std::copy(vivified.begin(), vivified.end(), clause.begin());
+  m_arena.shrink(cref, vivified.size());
+  if (clause.learnt && clause.lbd >= clause.size) {
+    clause.lbd = clause.size - 1;
+    if (tierFor(clause.lbd) < clause.getTier())
+      clause.setTier(tierFor(clause.lbd));
+  }
+  m_watches[clause[0]].push_back({cref, clause[1]});
+  m_watches[clause[1]].push_back({cref, clause[0]});
+  return true;
+}
+
+// Vivifies the clauses of crefs which were not vivified yet, or all of them
+// again once every one was, until the round used up its budget. Literals are
+// ordered by how many candidates contain them, and the candidates by their
+// ordered literals, so consecutive clauses share long prefixes of decisions
+bool Solver::vivifyClauses(std::vector<CRef> &crefs, bool learnt,
+                           uint64_t budget) {
+  std::vector<CRef> candidates;
+  for (bool again : {false, true}) {
+    for (CRef cref : crefs) {
+      ArenaClause &clause = m_arena[cref];
+      if (clause.garbage) continue;
+      if (learnt && clause.getTier() == ClauseTier::Local) continue;
+      if (again) clause.vivified = 0;
+      if (!clause.vivified) candidates.push_back(cref);
+    }
+    if (!candidates.empty()) break;
+  }
+
+  std::vector<unsigned> counts(m_numVars * 2, 0);
+  for (CRef cref : candidates) {
+    for (unsigned lit : m_arena[cref]) {
+      counts[lit]++;
+    }
+  }
+  auto before = [&](unsigned a, unsigned b) {
+    return counts[a] > counts[b] || (counts[a] == counts[b] && a < b);
+  };
+
+  std::vector<std::vector<unsigned>> lits(candidates.size());
+  std::vector<unsigned> order(candidates.size());
+  for (unsigned i = 0; i < candidates.size(); i++) {
+    ArenaClause &clause = m_arena[candidates[i]];
+    lits[i].assign(clause.begin(), clause.end());
+    std::sort(lits[i].begin(), lits[i].end(), before);
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [&](unsigned a, unsigned b) {
+    return std::lexicographical_compare(lits[a].begin(), lits[a].end(),
+                                        lits[b].begin(), lits[b].end(),
+                                        before);
+  });
+
+  uint64_t limit = m_ticks + budget;
+  for (unsigned i = 0; i < order.size() && m_ticks < limit; i++) {
+    CRef cref = candidates[order[i]];
+    ArenaClause &clause = m_arena[cref];
+    if (clause.garbage) continue;
+    clause.vivified = 1;
+
+    bool satisfied = false;
+    for (unsigned lit : clause) {
+      if (value(lit) == ValTrue && m_level[lit / 2] == 0) satisfied = true;
+    }
+    if (satisfied) continue;
+    if (!vivifyClause(cref, lits[order[i]])) return false;
+  }
+
+  backtrack(0, false);
+  crefs.erase(std::remove_if(crefs.begin(), crefs.end(),
+                             [&](CRef cref) { return m_arena[cref].garbage; }),
+              crefs.end());
+  return true;
+}
+
+// Vivification of the learnt clauses outside the local tier, then of the
+// irredundant ones, each with half the budget
+bool Solver::vivify(uint64_t budget) {
+  if (!m_opts.vivify) return true;
+
+  backtrack(0);
+  if (propagate() != CRefUndef) return false;
+  if (!vivifyClauses(m_learnts, true, budget / 2) ||
+      !vivifyClauses(m_clauses, false, budget / 2))
+    return false;
+
+  if (m_arena.wasted() > m_arena.size() * m_opts.garbageFraction)
+    collectGarbage();
+  return true;
+}
+
+} // namespace vasSAT
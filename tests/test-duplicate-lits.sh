@@ -0,0 +1,15 @@
+# Clauses with repeated literals, such as (-1 -1), and tautologies. Each
+# file name tells the expected result
+VASSAT=${VASSAT:-../build/run/bin/vasSAT}
+status=0
+for f in DUPLICATE-LITS/*.cnf; do
+  case $f in
+  *-unsat-*) expected=UNSAT ;;
+  *) expected=SAT ;;
+  esac
+  if ! $VASSAT -c $f | grep -q "RESULTS:$expected$"; then
+    echo "FAIL $f, expected $expected"
+    status=1
+  fi
+done
+exit $status
@@ -0,0 +1,12 @@
+# Incremental CNF files run through the IPASIR interface: clauses added
+# between solves, assumptions, models and failed assumptions. Each file is
+# compared with the expected output next to it
+VASSAT=${VASSAT:-../build/run/bin/vasSAT}
+status=0
+for f in INCREMENTAL/*.icnf; do
+  if ! $VASSAT -i $f | diff -u ${f%.icnf}.out - ; then
+    echo "FAIL $f"
+    status=1
+  fi
+done
+exit $status
@@ -0,0 +1,27 @@
+# Minimal unsatisfiable subsets of UNSAT CNF files: the printed subset must
+# be unsatisfiable and become satisfiable without any one of its clauses
+VASSAT=${VASSAT:-../build/run/bin/vasSAT}
+tmp=$(mktemp -d)
+status=0
+for f in UUF50.218.1000-UNSAT/uuf50-01.cnf UUF50.218.1000-UNSAT/uuf50-02.cnf \
+  UUF50.218.1000-UNSAT/uuf50-03.cnf UUF50.218.1000-UNSAT/uuf50-04.cnf \
+  UUF50.218.1000-UNSAT/uuf50-05.cnf; do
+  $VASSAT --mus -c $f | tail -n +2 > $tmp/mus.cnf
+  if ! $VASSAT -c $tmp/mus.cnf | grep -q "RESULTS:UNSAT$"; then
+    echo "FAIL $f, the subset is satisfiable"
+    status=1
+    continue
+  fi
+  clauses=$(grep -c " 0$" $tmp/mus.cnf)
+  for i in $(seq 1 $clauses); do
+    # line 1 is the header
+    sed "$((i + 1))d" $tmp/mus.cnf > $tmp/less.cnf
+    if ! $VASSAT -c $tmp/less.cnf | grep -q "RESULTS:SAT$"; then
+      echo "FAIL $f, the subset stays unsatisfiable without clause $i"
+      status=1
+      break
+    fi
+  done
+done
+rm -r $tmp
+exit $status